@@ -1,8 +1,29 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "prime_cache.h"
 #include "prime_printer.h"
 
-int main() {
-  std::vector<int> primes = generatePrimeNumbers();
-  printPrimeNumbers(primes);
+// Usage: ./printPrimeNumber [num_primes] [cache_file]
+// With a cache file the table is loaded from (and, if too short, extended
+// in) that file instead of being sieved on every run.
+int main(int argc, char *argv[]) {
+  const int kNumPrimes = argc > 1 ? std::stoi(argv[1]) : 300;
+  if (argc > 2) {
+    // Print straight from the shared mapping instead of a private copy.
+    PrimeTableCache cache(argv[2]);
+    try {
+      cache.reserve(kNumPrimes);
+    } catch (const std::runtime_error &error) {
+      std::cerr << error.what() << std::endl;
+      return 1;
+    }
+    printPrimeNumbersBuffered(cache.primes(), kNumPrimes);
+    return 0;
+  }
+  std::vector<int> primes = generatePrimeNumbers(kNumPrimes);
+  printPrimeNumbersBuffered(primes, kNumPrimes);
 
   return 0;
 }
@@ -1,8 +1,15 @@
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include "mapra_test.h"
+#include "miller_rabin.h"
+#include "prime_bitmap.h"
+#include "prime_cache.h"
 #include "prime_printer.h"
 
 void TestPrintPrimes() {
@@ -39,7 +46,185 @@ void TestPrintPrimes() {
   std::cout.rdbuf(original_cout_buffer);  // Restore cout to console
 }
 
+void TestPrintPrimesBuffered() {
+  mapra::MapraTest test("BufferedPrimePrintTester");
+
+  std::ifstream reference_file("PerfectPrint.txt", std::ios::binary);
+  std::stringstream reference;
+  reference << reference_file.rdbuf();
+
+  for (int num_primes : {300, 1, 199, 200, 201, 1000}) {
+    std::vector<int> primes = generatePrimeNumbers(num_primes);
+
+    std::ostringstream streamed;
+    std::streambuf *original_cout_buffer = std::cout.rdbuf(streamed.rdbuf());
+    printPrimeNumbers(primes, num_primes);
+    std::cout.rdbuf(original_cout_buffer);
+
+    std::ostringstream buffered;
+    printPrimeNumbersBuffered(primes, num_primes, buffered);
+    test.Assert(std::to_string(num_primes) + " primes match printPrimeNumbers",
+                buffered.str() == streamed.str());
+    if (num_primes == 300)
+      test.Assert("300 primes match PerfectPrint.txt byte by byte",
+                  buffered.str() == reference.str());
+  }
+}
+
+void TestLargePrimeTables() {
+  mapra::MapraTest test("LargePrimeTables");
+
+  std::vector<int> primes = generatePrimeNumbers(1000000);
+  test.AssertEq("Size", 1000001, static_cast<int>(primes.size()));
+  test.AssertEq("Prime 1", 2, primes[1]);
+  test.AssertEq("Prime 31", 127, primes[31]);
+  test.AssertEq("Prime 10^4", 104729, primes[10000]);
+  test.AssertEq("Prime 10^5", 1299709, primes[100000]);
+  test.AssertEq("Prime 10^6", 15485863, primes[1000000]);
+
+  for (int threads = 2; threads <= 4; threads++) {
+    test.Assert(std::to_string(threads) + " threads match sequential",
+                generatePrimeNumbers(1000000, threads) == primes);
+  }
+}
+
+void TestCompileTimePrimes() {
+  constexpr int kNumPrimes = 300;
+  constexpr auto kPrimes = compileTimePrimeNumbers<kNumPrimes>();
+  static_assert(kPrimes[1] == 2 && kPrimes[kNumPrimes] == 1987,
+                "compile-time table is evaluated at compile time");
+
+  mapra::MapraTest test("CompileTimePrimes");
+
+  std::vector<int> runtime_primes = generatePrimeNumbers(kNumPrimes);
+  test.Assert("Matches generatePrimeNumbers",
+              std::vector<int>(kPrimes.begin(), kPrimes.end()) ==
+                  runtime_primes);
+}
+
+void TestPrimeTableCache() {
+  const char *kCachePath = "PrimeCache.bin";
+
+  mapra::MapraTest test("PrimeTableCache");
+  remove(kCachePath);
+
+  test.Assert("Creates table",
+              generatePrimeNumbers(1000, kCachePath) ==
+                  generatePrimeNumbers(1000));
+  test.Assert("Serves shorter table",
+              generatePrimeNumbers(300, kCachePath) ==
+                  generatePrimeNumbers(300));
+  test.AssertEq("Not shrunk", 1000, PrimeTableCache(kCachePath).count());
+  test.Assert("Extends table",
+              generatePrimeNumbers(5000, kCachePath) ==
+                  generatePrimeNumbers(5000));
+  test.AssertEq("Extended", 5000, PrimeTableCache(kCachePath).count());
+
+  // A mapping of the shorter table stays valid while another cache object
+  // appends to the file.
+  PrimeTableCache reader(kCachePath);
+  const std::uint32_t *old_primes = reader.primes();
+  PrimeTableCache writer(kCachePath);
+  writer.reserve(100000);
+  const std::vector<int> kExpected = generatePrimeNumbers(100000);
+  test.Assert("Appends",
+              writer.count() == 100000 &&
+                  std::equal(kExpected.begin() + 1, kExpected.end(),
+                             writer.primes()));
+  test.Assert("Old mapping intact",
+              reader.count() == 5000 &&
+                  std::equal(kExpected.begin() + 1,
+                             kExpected.begin() + 5001, old_primes));
+
+  std::ostringstream copied, mapped;
+  printPrimeNumbersBuffered(kExpected, 1000, copied);
+  printPrimeNumbersBuffered(writer.primes(), 1000, mapped);
+  test.Assert("Prints from the mapping", copied.str() == mapped.str());
+
+  // Extending a table that holds only the prime 2.
+  remove(kCachePath);
+  PrimeTableCache(kCachePath).reserve(1);
+  test.Assert("Extends from 2",
+              generatePrimeNumbers(10, kCachePath) ==
+                  generatePrimeNumbers(10));
+
+  // Any other file is user data: reserve throws and leaves it unchanged.
+  const std::string kNotes = "important notes\n";
+  {
+    std::ofstream foreign(kCachePath, std::ios::binary | std::ios::trunc);
+    foreign << kNotes;
+  }
+  bool thrown = false;
+  try {
+    generatePrimeNumbers(300, kCachePath);
+  } catch (const std::runtime_error &) {
+    thrown = true;
+  }
+  std::ifstream foreign(kCachePath, std::ios::binary);
+  std::stringstream contents;
+  contents << foreign.rdbuf();
+  test.Assert("Refuses foreign file", thrown && contents.str() == kNotes);
+
+  remove(kCachePath);
+}
+
+void TestMillerRabin() {
+  mapra::MapraTest test("MillerRabin");
+
+  PrimeBitmap bitmap(1000000);
+  bool small_ok = true;
+  for (int n = 0; n <= bitmap.limit(); n++)
+    small_ok = small_ok && isPrime64(n) == bitmap.isPrime(n);
+  test.Assert("Agrees with sieve up to 10^6", small_ok);
+
+  const std::uint64_t kCandidates[] = {
+      561,                     // Carmichael number
+      3215031751,              // strong pseudoprime to bases 2, 3, 5, 7
+      2305843009213693951,     // 2^61 - 1
+      4611686014132420609,     // (2^31 - 1)^2
+      18446744073709551557u,   // largest 64-bit prime
+      18446744073709551615u};  // 2^64 - 1
+  const bool kExpected[] = {false, false, true, false, true, false};
+  bool results[6];
+  isPrime64Batch(kCandidates, 6, results);
+  for (int i = 0; i < 6; i++)
+    test.AssertEq(std::to_string(kCandidates[i]), kExpected[i], results[i]);
+}
+
+void TestPrimeBitmap() {
+  const int kNumPrimes = 10000;
+
+  mapra::MapraTest test("PrimeBitmap");
+
+  std::vector<int> primes = generatePrimeNumbers(kNumPrimes);
+  PrimeBitmap bitmap(primes[kNumPrimes]);
+  test.AssertEq("Count", kNumPrimes, bitmap.count());
+
+  bool is_prime_ok = true;
+  bool pi_ok = true;
+  int index = 1;
+  for (int n = 0; n <= bitmap.limit(); n++) {
+    const bool kExpected = index <= kNumPrimes && primes[index] == n;
+    is_prime_ok = is_prime_ok && bitmap.isPrime(n) == kExpected;
+    if (kExpected) index++;
+    pi_ok = pi_ok && bitmap.pi(n) == index - 1;
+  }
+  test.Assert("isPrime matches table", is_prime_ok);
+  test.Assert("pi matches table", pi_ok);
+
+  bool nth_prime_ok = true;
+  for (int k = 1; k <= kNumPrimes; k++)
+    nth_prime_ok = nth_prime_ok && bitmap.nthPrime(k) == primes[k];
+  test.Assert("nthPrime matches table", nth_prime_ok);
+}
+
 int main() {
   TestPrintPrimes();
+  TestPrintPrimesBuffered();
+  TestLargePrimeTables();
+  TestCompileTimePrimes();
+  TestPrimeTableCache();
+  TestPrimeBitmap();
+  TestMillerRabin();
   return 0;
 }
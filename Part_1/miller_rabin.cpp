@@ -0,0 +1,96 @@
+#include "miller_rabin.h"
+
+__extension__ typedef unsigned __int128 UInt128;
+
+// Arithmetic modulo an odd n in Montgomery form (R = 2^64), so that
+// multiplications need no 128-bit division.
+class Montgomery {
+ public:
+  explicit Montgomery(std::uint64_t n) : n_(n), n_inv_(n) {
+    // Newton iteration: each step doubles the number of correct low bits.
+    for (int i = 0; i < 5; i++) n_inv_ *= 2 - n_ * n_inv_;
+    one_ = (0 - n_) % n_;  // R mod n
+    r_squared_ = static_cast<UInt128>(one_) * one_ % n_;
+  }
+
+  std::uint64_t one() const { return one_; }
+  std::uint64_t minusOne() const { return n_ - one_; }
+
+  std::uint64_t toMontgomery(std::uint64_t a) const {
+    return multiply(a % n_, r_squared_);
+  }
+
+  std::uint64_t multiply(std::uint64_t a, std::uint64_t b) const {
+    return reduce(static_cast<UInt128>(a) * b);
+  }
+
+  std::uint64_t power(std::uint64_t base, std::uint64_t exponent) const {
+    std::uint64_t result = one_;
+    while (exponent != 0) {
+      if (exponent & 1) result = multiply(result, base);
+      base = multiply(base, base);
+      exponent >>= 1;
+    }
+    return result;
+  }
+
+ private:
+  // t * R^-1 mod n for t < n * R.
+  std::uint64_t reduce(UInt128 t) const {
+    const std::uint64_t kM = static_cast<std::uint64_t>(t) * n_inv_;
+    const std::uint64_t kHigh = t >> 64;
+    const std::uint64_t kCorrection = (static_cast<UInt128>(kM) * n_) >> 64;
+    return kHigh >= kCorrection ? kHigh - kCorrection
+                                : kHigh - kCorrection + n_;
+  }
+
+  std::uint64_t n_;
+  std::uint64_t n_inv_;  // n^-1 mod R
+  std::uint64_t one_;
+  std::uint64_t r_squared_;
+};
+
+// These seven bases make the test exact for every n < 2^64 (J. Sinclair).
+static const std::uint64_t kBases[7] = {2,      325,     9375,      28178,
+                                        450775, 9780504, 1795265022};
+
+static const std::uint64_t kSmallPrimes[12] = {2,  3,  5,  7,  11, 13,
+                                               17, 19, 23, 29, 31, 37};
+
+bool isPrime64(std::uint64_t n) {
+  if (n < 2) return false;
+  for (std::uint64_t prime : kSmallPrimes) {
+    if (n % prime == 0) return n == prime;
+  }
+  if (n < 41 * 41) return true;
+
+  // n - 1 = d * 2^s with d odd
+  int s = 0;
+  std::uint64_t d = n - 1;
+  while ((d & 1) == 0) {
+    d >>= 1;
+    s++;
+  }
+
+  const Montgomery kMont(n);
+  for (std::uint64_t base : kBases) {
+    const std::uint64_t kBase = base % n;
+    if (kBase == 0) continue;
+
+    std::uint64_t x = kMont.power(kMont.toMontgomery(kBase), d);
+    if (x == kMont.one() || x == kMont.minusOne()) continue;
+
+    bool witness = true;
+    for (int r = 1; r < s && witness; r++) {
+      x = kMont.multiply(x, x);
+      if (x == kMont.minusOne()) witness = false;
+    }
+    if (witness) return false;
+  }
+  return true;
+}
+
+void isPrime64Batch(const std::uint64_t *candidates, std::size_t count,
+                    bool *results) {
+  for (std::size_t i = 0; i < count; i++) results[i] = isPrime64(candidates[i]);
+}
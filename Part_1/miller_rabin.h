@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Deterministic Miller-Rabin test for the full 64-bit range. Unlike
+// isPrime(number, primes, multiples, current_ord) it needs no prime table
+// and can be called for any number in any order.
+bool isPrime64(std::uint64_t n);
+
+// Tests candidates[0 .. count) and stores the answers in results.
+void isPrime64Batch(const std::uint64_t *candidates, std::size_t count,
+                    bool *results);
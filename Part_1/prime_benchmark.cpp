@@ -0,0 +1,241 @@
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "prime_bitmap.h"
+#include "prime_printer.h"
+#include "prime_sieve.h"
+
+// Benchmark of the prime engines. Every measurement runs in a forked child
+// so that the reported peak RSS belongs to that engine and size only.
+//
+// Usage: ./primeBenchmark [--format=csv|json] [--min-exp=3] [--max-exp=7]
+//                         [--threads=T] [--scaling=NUM_PRIMES]
+// --scaling prints the thread scaling table for 1..T threads instead.
+
+struct Engine {
+  std::string name;
+  // Computes the first num_primes primes, returns the last one.
+  std::function<long long(int)> run;
+};
+
+struct Measurement {
+  double seconds = 0.0;  // -1 if the measurement failed
+  long long last_prime = 0;
+  long long cache_misses = -1;  // -1 if perf_event_open is unavailable
+  long long peak_rss_kb = 0;
+};
+
+// Opens a hardware cache-miss counter for the calling thread and its
+// children, or returns -1.
+static int openCacheMissCounter() {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = PERF_COUNT_HW_CACHE_MISSES;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static Measurement failedMeasurement(const char *what) {
+  std::cerr << "primeBenchmark: " << what << ": " << std::strerror(errno)
+            << "\n";
+  Measurement result;
+  result.seconds = -1.0;
+  return result;
+}
+
+static Measurement measure(const Engine &engine, int num_primes) {
+  int result_pipe[2];
+  if (pipe(result_pipe) != 0) return failedMeasurement("pipe");
+
+  const pid_t kChild = fork();
+  if (kChild < 0) {
+    const Measurement kFailed = failedMeasurement("fork");
+    close(result_pipe[0]);
+    close(result_pipe[1]);
+    return kFailed;
+  }
+  if (kChild == 0) {
+    close(result_pipe[0]);
+    Measurement result;
+    const int kCounter = openCacheMissCounter();
+    if (kCounter >= 0) {
+      ioctl(kCounter, PERF_EVENT_IOC_RESET, 0);
+      ioctl(kCounter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    const auto kStart = std::chrono::steady_clock::now();
+    result.last_prime = engine.run(num_primes);
+    const std::chrono::duration<double> kElapsed =
+        std::chrono::steady_clock::now() - kStart;
+    result.seconds = kElapsed.count();
+
+    if (kCounter >= 0) {
+      ioctl(kCounter, PERF_EVENT_IOC_DISABLE, 0);
+      long long misses = 0;
+      if (read(kCounter, &misses, sizeof(misses)) == sizeof(misses))
+        result.cache_misses = misses;
+      close(kCounter);
+    }
+    if (write(result_pipe[1], &result, sizeof(result)) != sizeof(result))
+      _exit(1);
+    _exit(0);
+  }
+
+  close(result_pipe[1]);
+  Measurement result;
+  const bool kReceived =
+      read(result_pipe[0], &result, sizeof(result)) == sizeof(result);
+  close(result_pipe[0]);
+
+  int status = 0;
+  rusage usage{};
+  if (wait4(kChild, &status, 0, &usage) != kChild)
+    return failedMeasurement("wait4");
+  if (!kReceived) result.seconds = -1.0;
+  result.peak_rss_kb = usage.ru_maxrss;
+  return result;
+}
+
+static void printThreadScaling(int num_primes, int max_threads) {
+  std::cout << "threads,seconds,speedup,last_prime\n";
+  double baseline = 0.0;
+  for (int threads = 1; threads <= max_threads; threads++) {
+    const auto kStart = std::chrono::steady_clock::now();
+    std::vector<int> primes = generatePrimeNumbers(num_primes, threads);
+    const std::chrono::duration<double> kElapsed =
+        std::chrono::steady_clock::now() - kStart;
+
+    if (threads == 1) baseline = kElapsed.count();
+    std::cout << threads << ',' << kElapsed.count() << ','
+              << baseline / kElapsed.count() << ',' << primes[num_primes]
+              << std::endl;
+  }
+}
+
+int main(int argc, char *argv[]) {
+  std::string format = "csv";
+  int min_exp = 3;
+  int max_exp = 7;
+  int scaling_primes = 0;
+  const unsigned kHardwareThreads = std::thread::hardware_concurrency();
+  int threads = kHardwareThreads ? kHardwareThreads : 1;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string kArg = argv[i];
+    const std::size_t kEq = kArg.find('=');
+    const std::string kKey = kArg.substr(0, kEq);
+    const std::string kValue =
+        kEq == std::string::npos ? "" : kArg.substr(kEq + 1);
+    if (kKey == "--format") {
+      format = kValue;
+    } else if (kKey == "--min-exp") {
+      min_exp = std::stoi(kValue);
+    } else if (kKey == "--max-exp") {
+      max_exp = std::stoi(kValue);
+    } else if (kKey == "--threads") {
+      threads = std::stoi(kValue);
+    } else if (kKey == "--scaling") {
+      scaling_primes = std::stoi(kValue);
+    } else {
+      std::cerr << "Unknown argument " << kArg << "\n";
+      return 1;
+    }
+  }
+
+  // 10^9 primes are more than an int table can hold (kMaxPrimeCount), and
+  // num_primes itself would overflow from 10^10 on.
+  const int kMaxExp = 8;
+  if (min_exp < 0 || max_exp > kMaxExp) {
+    std::cerr << "--min-exp and --max-exp must lie in 0.." << kMaxExp
+              << "\n";
+    return 1;
+  }
+
+  if (scaling_primes > 0) {
+    printThreadScaling(scaling_primes, threads);
+    return 0;
+  }
+
+  const std::vector<Engine> kEngines = {
+      {"generatePrimeNumbers",
+       [](int n) { return generatePrimeNumbers(n)[n]; }},
+      {"generatePrimeNumbers/" + std::to_string(threads) + "threads",
+       [threads](int n) { return generatePrimeNumbers(n, threads)[n]; }},
+      {"PrimeBitmap",
+       [](int n) {
+         PrimeBitmap bitmap(static_cast<int>(nthPrimeUpperBound(n)));
+         return bitmap.nthPrime(n);
+       }},
+  };
+
+  const bool kJson = format == "json";
+  if (kJson)
+    std::cout << "[\n";
+  else
+    std::cout << "engine,num_primes,seconds,primes_per_second,peak_rss_kb,"
+                 "cache_misses\n";
+
+  // A failed measurement (fork failed, engine crashed) gets null / empty
+  // fields instead of numbers, and the exit status is 1.
+  bool first = true;
+  bool failed = false;
+  for (const Engine &engine : kEngines) {
+    int num_primes = 1;
+    for (int e = 0; e < min_exp; e++) num_primes *= 10;
+    for (int e = min_exp; e <= max_exp; e++, num_primes *= 10) {
+      const Measurement kResult = measure(engine, num_primes);
+      const bool kOk = kResult.seconds >= 0.0;
+      failed = failed || !kOk;
+      const double kRate = num_primes / kResult.seconds;
+      if (kJson) {
+        std::cout << (first ? "" : ",\n") << "  {\"engine\": \"" << engine.name
+                  << "\", \"num_primes\": " << num_primes;
+        if (kOk)
+          std::cout << ", \"seconds\": " << kResult.seconds
+                    << ", \"primes_per_second\": " << kRate
+                    << ", \"peak_rss_kb\": " << kResult.peak_rss_kb;
+        else
+          std::cout << ", \"seconds\": null, \"primes_per_second\": null"
+                    << ", \"peak_rss_kb\": null";
+        std::cout << ", \"cache_misses\": ";
+        if (!kOk || kResult.cache_misses < 0)
+          std::cout << "null}";
+        else
+          std::cout << kResult.cache_misses << "}";
+      } else {
+        std::cout << engine.name << ',' << num_primes << ',';
+        if (kOk)
+          std::cout << kResult.seconds << ',' << kRate << ','
+                    << kResult.peak_rss_kb << ',';
+        else
+          std::cout << ",,,";
+        if (kOk && kResult.cache_misses >= 0)
+          std::cout << kResult.cache_misses;
+        std::cout << "\n";
+      }
+      std::cout.flush();
+      first = false;
+    }
+  }
+  if (kJson) std::cout << "\n]\n";
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+#include "prime_bitmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "prime_sieve.h"
+
+// Residues modulo 30 that are coprime to 30, i.e. the wheel spokes.
+static const int kResidues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+// Bit position of residue r inside its byte, -1 if r shares a factor
+// with 30.
+static const int kBitOfResidue[30] = {-1, 0,  -1, -1, -1, -1, -1, 1,
+                                      -1, -1, -1, 2,  -1, 3,  -1, -1,
+                                      -1, 4,  -1, 5,  -1, -1, -1, 6,
+                                      -1, -1, -1, -1, -1, 7};
+
+// Number of wheel spokes s with s <= r.
+static const int kResiduesUpTo[30] = {0, 1, 1, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 4, 4, 4, 4, 5, 5, 6,
+                                      6, 6, 6, 7, 7, 7, 7, 7, 7, 8};
+
+// Number of wheel bits that belong to candidates c <= n.
+static std::uint64_t bitsUpTo(int n) {
+  return static_cast<std::uint64_t>(n / 30) * 8 + kResiduesUpTo[n % 30];
+}
+
+PrimeBitmap::PrimeBitmap(int limit) : limit_(limit) {
+  if (limit < 0)
+    throw std::invalid_argument("PrimeBitmap: negative limit " +
+                                std::to_string(limit));
+
+  const std::uint64_t kNumWords = (bitsUpTo(limit) + 63) / 64;
+  words_.assign(kNumWords, 0);
+  block_rank_.assign(kNumWords / kWordsPerBlock + 1, 0);
+
+  const int kSqrtLimit = static_cast<int>(std::sqrt(limit)) + 1;
+  const std::vector<int> kBasePrimes = basePrimesUpTo(kSqrtLimit);
+
+  // Reuse the segmented engine and fold each odd prime > 5 into the wheel.
+  std::vector<char> flags;
+  const long long kSegmentSpan = 2LL * kSegmentBytes;
+  for (long long low = 1; low <= limit; low += kSegmentSpan) {
+    const long long kHigh = std::min(low + kSegmentSpan, limit + 1LL);
+    sieveSegment(low, kHigh, kBasePrimes, flags);
+
+    for (std::size_t i = 0; i < flags.size(); i++) {
+      const long long kNumber = low + 2 * (long long)i;
+      if (!flags[i] || kNumber <= 5) continue;
+      const std::uint64_t kBit =
+          static_cast<std::uint64_t>(kNumber / 30) * 8 +
+          kBitOfResidue[kNumber % 30];
+      words_[kBit / 64] |= std::uint64_t{1} << (kBit % 64);
+    }
+  }
+
+  std::uint32_t running = 0;
+  for (std::size_t word = 0; word < words_.size(); word++) {
+    if (word % kWordsPerBlock == 0)
+      block_rank_[word / kWordsPerBlock] = running;
+    running += __builtin_popcountll(words_[word]);
+  }
+  if (words_.size() % kWordsPerBlock == 0) block_rank_.back() = running;
+
+  count_ = pi(limit);
+}
+
+int PrimeBitmap::rankBits(std::uint64_t bit) const {
+  const std::uint64_t kWord = bit / 64;
+  const std::uint64_t kBlock = kWord / kWordsPerBlock;
+
+  int rank = block_rank_[kBlock];
+  for (std::uint64_t word = kBlock * kWordsPerBlock; word < kWord; word++)
+    rank += __builtin_popcountll(words_[word]);
+
+  const int kOffset = bit % 64;
+  if (kOffset != 0) {
+    const std::uint64_t kMask = (std::uint64_t{1} << kOffset) - 1;
+    rank += __builtin_popcountll(words_[kWord] & kMask);
+  }
+  return rank;
+}
+
+bool PrimeBitmap::isPrime(int n) const {
+  if (n < 0 || n > limit_)
+    throw std::out_of_range("PrimeBitmap::isPrime: " + std::to_string(n) +
+                            " outside [0, " + std::to_string(limit_) + "]");
+  if (n < 7) return n == 2 || n == 3 || n == 5;
+
+  const int kBitInByte = kBitOfResidue[n % 30];
+  if (kBitInByte < 0) return false;
+  const std::uint64_t kBit =
+      static_cast<std::uint64_t>(n / 30) * 8 + kBitInByte;
+  return (words_[kBit / 64] >> (kBit % 64)) & 1;
+}
+
+int PrimeBitmap::pi(int n) const {
+  if (n < 0 || n > limit_)
+    throw std::out_of_range("PrimeBitmap::pi: " + std::to_string(n) +
+                            " outside [0, " + std::to_string(limit_) + "]");
+  if (n < 5) return (n >= 2) + (n >= 3);
+  return 3 + rankBits(bitsUpTo(n));
+}
+
+int PrimeBitmap::nthPrime(int k) const {
+  if (k < 1 || k > count_)
+    throw std::out_of_range("PrimeBitmap::nthPrime: " + std::to_string(k) +
+                            " outside [1, " + std::to_string(count_) + "]");
+  static const int kWheelPrimes[3] = {2, 3, 5};
+  if (k <= 3) return kWheelPrimes[k - 1];
+
+  // Locate the rank block holding the target bit, then the word inside it.
+  std::uint32_t target = k - 3;
+  const auto kAfter =
+      std::upper_bound(block_rank_.begin(), block_rank_.end(), target - 1);
+  const std::size_t kBlock = (kAfter - block_rank_.begin()) - 1;
+  target -= block_rank_[kBlock];
+
+  std::size_t word = kBlock * kWordsPerBlock;
+  while (true) {
+    const std::uint32_t kPopcount = __builtin_popcountll(words_[word]);
+    if (target <= kPopcount) break;
+    target -= kPopcount;
+    word++;
+  }
+
+  // Select the target-th set bit inside the word.
+  std::uint64_t bits = words_[word];
+  for (std::uint32_t skip = 1; skip < target; skip++) bits &= bits - 1;
+  const std::uint64_t kBit = word * 64 + __builtin_ctzll(bits);
+  return static_cast<int>(kBit / 8 * 30 + kResidues[kBit % 8]);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Compact table of all primes up to a limit. Uses a mod-30 wheel: only the
+// eight residues coprime to 30 are stored, one bit each, so every 30
+// integers take a single byte. Unlike isPrime(number, primes, multiples,
+// current_ord) no state has to be threaded through the calls, so lookups
+// can be done in any order.
+class PrimeBitmap {
+ public:
+  // Sieves all primes p <= limit.
+  explicit PrimeBitmap(int limit);
+
+  // O(1) membership test, 0 <= n <= limit().
+  bool isPrime(int n) const;
+
+  // Number of primes p <= n (rank), 0 <= n <= limit().
+  int pi(int n) const;
+
+  // The k-th prime with the 1-based indexing of generatePrimeNumbers, so
+  // nthPrime(1) == 2 (select), 1 <= k <= count().
+  int nthPrime(int k) const;
+
+  int limit() const { return limit_; }
+  int count() const { return count_; }
+
+ private:
+  // Each rank block covers kWordsPerBlock 64-bit words (512 candidates).
+  static const int kWordsPerBlock = 8;
+
+  // Number of stored primes in front of wheel bit `bit`.
+  int rankBits(std::uint64_t bit) const;
+
+  int limit_;
+  int count_ = 0;
+  std::vector<std::uint64_t> words_;
+  std::vector<std::uint32_t> block_rank_;  // primes in words before block
+};
@@ -0,0 +1,181 @@
+#include "prime_cache.h"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "prime_sieve.h"
+
+static const char kMagic[8] = {'P', 'R', 'I', 'M', 'T', 'B', 'L', '\0'};
+static const std::uint32_t kVersion = 1;
+
+PrimeTableCache::PrimeTableCache(const std::string &path) : path_(path) {
+  map();
+}
+
+PrimeTableCache::~PrimeTableCache() { unmap(); }
+
+// Reads the header of the table in fd. False if the file is empty,
+// truncated or foreign. Entries behind header.count (left by an
+// interrupted extension) are ignored.
+static bool readHeader(int fd, PrimeTableHeader &header) {
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      info.st_size < static_cast<off_t>(sizeof(PrimeTableHeader)) ||
+      pread(fd, &header, sizeof(header), 0) !=
+          static_cast<ssize_t>(sizeof(header)))
+    return false;
+  const std::size_t kPayload = info.st_size - sizeof(PrimeTableHeader);
+  return std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+         header.version == kVersion &&
+         header.entry_bytes == sizeof(std::uint32_t) &&
+         header.count <= static_cast<std::uint64_t>(kMaxPrimeCount) &&
+         header.count * sizeof(std::uint32_t) <= kPayload;
+}
+
+void PrimeTableCache::map() {
+  const int kFd = open(path_.c_str(), O_RDONLY);
+  if (kFd < 0) return;  // no cache yet
+
+  // The shared lock keeps a writer from updating the header while it is
+  // read. It must be dropped explicitly: the mapping keeps the open file
+  // alive, so close() alone would hold the lock until munmap.
+  PrimeTableHeader header;
+  if (flock(kFd, LOCK_SH) != 0 || !readHeader(kFd, header)) {
+    close(kFd);  // empty or not a table; reserve() decides what to do
+    return;
+  }
+  // Only the entries the header counts; a writer may be appending more.
+  const std::size_t kBytes =
+      sizeof(header) + header.count * sizeof(std::uint32_t);
+  void *mapping = mmap(nullptr, kBytes, PROT_READ, MAP_SHARED, kFd, 0);
+  flock(kFd, LOCK_UN);
+  close(kFd);  // the mapping keeps the file alive
+  if (mapping == MAP_FAILED) return;
+
+  mapping_ = mapping;
+  mapping_bytes_ = kBytes;
+  primes_ = reinterpret_cast<const std::uint32_t *>(
+      static_cast<const char *>(mapping) + sizeof(header));
+  count_ = static_cast<int>(header.count);
+}
+
+void PrimeTableCache::unmap() {
+  if (mapping_ != nullptr) munmap(mapping_, mapping_bytes_);
+  mapping_ = nullptr;
+  mapping_bytes_ = 0;
+  primes_ = nullptr;
+  count_ = 0;
+}
+
+// The num_new primes following `last` (0 for an empty table), sieved
+// segment by segment from last + 1 on. p_total bounds the range.
+static std::vector<std::uint32_t> sievePrimesAfter(std::uint32_t last,
+                                                   int num_new, int total) {
+  std::vector<std::uint32_t> primes;
+  primes.reserve(num_new);
+  if (last < 2) {
+    primes.push_back(2);
+    last = 2;
+  }
+
+  const long long kLimit = nthPrimeUpperBound(total);
+  const int kSqrtLimit =
+      static_cast<int>(std::sqrt(static_cast<double>(kLimit))) + 1;
+  const std::vector<int> kBasePrimes = basePrimesUpTo(kSqrtLimit);
+
+  std::vector<char> flags;
+  const long long kSegmentSpan = 2LL * kSegmentBytes;
+  for (long long low = last + 1 + last % 2;  // the first odd number > last
+       low <= kLimit && static_cast<int>(primes.size()) < num_new;
+       low += kSegmentSpan) {
+    const long long kHigh = std::min(low + kSegmentSpan, kLimit + 1);
+    sieveSegment(low, kHigh, kBasePrimes, flags);
+    for (std::size_t i = 0;
+         i < flags.size() && static_cast<int>(primes.size()) < num_new; i++)
+      if (flags[i])
+        primes.push_back(static_cast<std::uint32_t>(low + 2 * (long long)i));
+  }
+  return primes;
+}
+
+void PrimeTableCache::reserve(int num_primes) {
+  if (num_primes <= count_) return;
+  if (num_primes > kMaxPrimeCount)
+    throw std::out_of_range("PrimeTableCache: cannot represent " +
+                            std::to_string(num_primes) + " primes as int");
+
+  const int kFd = open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+  if (kFd < 0)
+    throw std::runtime_error("PrimeTableCache: cannot open " + path_);
+  // Serializes the writers; readers never lock.
+  if (flock(kFd, LOCK_EX) != 0) {
+    close(kFd);
+    throw std::runtime_error("PrimeTableCache: cannot lock " + path_);
+  }
+
+  // Read the table again under the lock: another process may have
+  // extended it since it was mapped.
+  PrimeTableHeader header;
+  std::uint32_t last = 0;
+  bool ok = true;
+  if (readHeader(kFd, header)) {
+    if (header.count > 0)
+      ok = pread(kFd, &last, sizeof(last),
+                 sizeof(header) + (header.count - 1) * sizeof(last)) ==
+           static_cast<ssize_t>(sizeof(last));
+  } else {
+    // Only a new, empty file becomes a table. Anything else may be user
+    // data (e.g. a mistyped path) and is left alone.
+    struct stat info;
+    if (fstat(kFd, &info) != 0 || info.st_size != 0) {
+      close(kFd);
+      throw std::runtime_error("PrimeTableCache: " + path_ +
+                               " is not a prime table");
+    }
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.entry_bytes = sizeof(std::uint32_t);
+    header.count = 0;
+    ok = pwrite(kFd, &header, sizeof(header), 0) ==
+         static_cast<ssize_t>(sizeof(header));
+  }
+
+  if (ok && header.count < static_cast<std::uint64_t>(num_primes)) {
+    // Append the new entries first and raise the count afterwards, so a
+    // reader sees either the old table or the complete new one.
+    const std::vector<std::uint32_t> kEntries = sievePrimesAfter(
+        last, num_primes - static_cast<int>(header.count), num_primes);
+    const ssize_t kBytes = kEntries.size() * sizeof(std::uint32_t);
+    ok = pwrite(kFd, kEntries.data(), kBytes,
+                sizeof(header) + header.count * sizeof(std::uint32_t)) ==
+         kBytes;
+    header.count += kEntries.size();
+    ok = ok && pwrite(kFd, &header, sizeof(header), 0) ==
+                   static_cast<ssize_t>(sizeof(header));
+  }
+  close(kFd);  // also releases the lock
+  if (!ok) throw std::runtime_error("PrimeTableCache: cannot write " + path_);
+
+  unmap();
+  map();
+  if (count_ < num_primes)
+    throw std::runtime_error("PrimeTableCache: cannot map " + path_);
+}
+
+std::vector<int> PrimeTableCache::table(int num_primes) {
+  if (num_primes < 1) return std::vector<int>(1);
+  reserve(num_primes);
+
+  std::vector<int> primes(num_primes + 1);
+  std::copy(primes_, primes_ + num_primes, primes.begin() + 1);
+  return primes;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk prime table, shared between runs and processes via mmap.
+//
+// File layout (native byte order):
+//   PrimeTableHeader
+//   count x uint32_t   raw primes p_1 = 2, p_2 = 3, ..., p_count
+//
+// The table only grows. A writer holds an exclusive flock, appends the new
+// entries behind the old ones and then raises count in the header. Readers
+// take a shared flock while they read the header and map the entries, so
+// they see either the old or the extended table, never a half-written
+// header. A file that is neither empty nor a table is never overwritten.
+struct PrimeTableHeader {
+  char magic[8];  // "PRIMTBL\0"
+  std::uint32_t version;
+  std::uint32_t entry_bytes;  // always sizeof(std::uint32_t)
+  std::uint64_t count;
+};
+
+class PrimeTableCache {
+ public:
+  // Maps `path` read-only if it holds a valid table, otherwise starts empty.
+  explicit PrimeTableCache(const std::string &path);
+  ~PrimeTableCache();
+  PrimeTableCache(const PrimeTableCache &) = delete;
+  PrimeTableCache &operator=(const PrimeTableCache &) = delete;
+
+  // Makes sure at least num_primes primes are cached. If the file holds
+  // fewer, only the missing primes are sieved, starting behind the last
+  // cached one, and appended; mappings of the shorter table stay valid.
+  // Throws std::runtime_error if the file exists, is not empty and is not
+  // a prime table.
+  void reserve(int num_primes);
+
+  int count() const { return count_; }
+
+  // primes()[0] == 2; points into the mapping, valid until the next reserve.
+  const std::uint32_t *primes() const { return primes_; }
+
+  // Copy of the first num_primes cached primes in the 1-based
+  // generatePrimeNumbers layout. Calls reserve(num_primes) first. Every
+  // caller gets a private copy; read primes() to share the mapped table.
+  std::vector<int> table(int num_primes);
+
+ private:
+  void map();
+  void unmap();
+
+  std::string path_;
+  void *mapping_ = nullptr;
+  std::size_t mapping_bytes_ = 0;
+  const std::uint32_t *primes_ = nullptr;
+  int count_ = 0;
+};
@@ -4,6 +4,9 @@
 #include <iostream>
 #include <string>
 
+#include "prime_cache.h"
+#include "prime_sieve.h"
+
 bool isPrime(int number, const std::vector<int> &primes,
              std::vector<int> &multiples, int current_ord) {
   if (number == 2) return true;
@@ -25,32 +28,15 @@ bool isPrime(int number, const std::vector<int> &primes,
   return is_prime;
 }
 
-std::vector<int> generatePrimeNumbers(int num_primes) {
-  const int kMaxOrd = 30;
-
-  std::vector<int> multiples(kMaxOrd + 1);
-  std::vector<int> primes(num_primes + 1);
-
-  int current_number = 1;
-  int prime_count = 1;
-  int current_ord = 2;
-  int current_square = 9;
-
-  primes[1] = 2;
+std::vector<int> generatePrimeNumbers(int num_primes, int num_threads) {
+  if (num_threads > 1) return sieveFirstPrimesParallel(num_primes, num_threads);
+  return sieveFirstPrimes(num_primes);
+}
 
-  while (prime_count < num_primes) {
-    current_number += 2;
-    if (current_number == current_square) {
-      current_ord++;
-      current_square = primes[current_ord] * primes[current_ord];
-      multiples[current_ord - 1] = current_number;
-    }
-    if (isPrime(current_number, primes, multiples, current_ord)) {
-      prime_count++;
-      primes[prime_count] = current_number;
-    }
-  }
-  return primes;
+std::vector<int> generatePrimeNumbers(int num_primes,
+                                      const std::string &cache_path) {
+  PrimeTableCache cache(cache_path);
+  return cache.table(num_primes);
 }
 
 void printPrimeNumbersByLine(const std::vector<int> &primes, int row_offset,
@@ -87,3 +73,79 @@ void printPrimeNumbers(std::vector<int> &primes, int num_primes) {
     page_offset += kRowsPerPage * kColumnsPerRow;
   }
 }
+
+// Writes `value` right-aligned into a field of `width` characters (like
+// std::setw) starting at `out` and returns the position behind it.
+static char *appendPadded(char *out, int value, int width) {
+  char digits[12];
+  int length = 0;
+  unsigned int rest = value < 0 ? 0u - static_cast<unsigned int>(value)
+                                : static_cast<unsigned int>(value);
+  do {
+    digits[length++] = static_cast<char>('0' + rest % 10);
+    rest /= 10;
+  } while (rest != 0);
+  if (value < 0) digits[length++] = '-';
+
+  for (int pad = length; pad < width; pad++) *out++ = ' ';
+  while (length > 0) *out++ = digits[--length];
+  return out;
+}
+
+static char *appendText(char *out, const char *text) {
+  while (*text != '\0') *out++ = *text++;
+  return out;
+}
+
+// primeAt(k) is the k-th prime, 1-based.
+template <typename PrimeAt>
+static void printPagesBuffered(PrimeAt primeAt, int num_primes,
+                               std::ostream &out) {
+  const int kFieldWidth = 10;
+  const int kMaxFieldLength = 11;  // an int never needs more than 11 chars
+  const int kMaxLineLength = kColumnsPerRow * kMaxFieldLength + 1;
+  const int kMaxHeaderLength = 64;
+  std::vector<char> buffer(kMaxHeaderLength + kRowsPerPage * kMaxLineLength +
+                           2);
+
+  int page_number = 1;
+  int page_offset = 1;
+  while (page_offset <= num_primes) {
+    char *cursor = buffer.data();
+    cursor = appendText(cursor, "The First ");
+    cursor = appendPadded(cursor, num_primes, 0);
+    cursor = appendText(cursor, " Prime Numbers --- Page ");
+    cursor = appendPadded(cursor, page_number, 0);
+    *cursor++ = '\n';
+
+    for (int row = 0; row < kRowsPerPage; row++) {
+      int row_offset = page_offset + row;
+      if (row_offset > num_primes) break;
+      for (int column_idx = 0; column_idx < kColumnsPerRow; column_idx++) {
+        int index = row_offset + column_idx * kRowsPerPage;
+        if (index <= num_primes)
+          cursor = appendPadded(cursor, primeAt(index), kFieldWidth);
+      }
+      *cursor++ = '\n';
+    }
+
+    *cursor++ = '\f';
+    *cursor++ = '\n';
+    out.write(buffer.data(), cursor - buffer.data());
+    page_number++;
+    page_offset += kRowsPerPage * kColumnsPerRow;
+  }
+  out.flush();
+}
+
+void printPrimeNumbersBuffered(const std::vector<int> &primes, int num_primes,
+                               std::ostream &out) {
+  printPagesBuffered([&primes](int k) { return primes[k]; }, num_primes, out);
+}
+
+void printPrimeNumbersBuffered(const std::uint32_t *table, int num_primes,
+                               std::ostream &out) {
+  printPagesBuffered(
+      [table](int k) { return static_cast<int>(table[k - 1]); }, num_primes,
+      out);
+}
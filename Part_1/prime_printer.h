@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -10,9 +13,52 @@ const int kColumnsPerRow = 4;
 bool isPrime(int number, const std::vector<int> &primes,
              std::vector<int> &multiples, int current_ord);
 
-std::vector<int> generatePrimeNumbers(int num_primes = 300);
+// First num_primes primes, 1-based (primes[1] == 2). With num_threads > 1
+// the sieve segments are split across that many worker threads.
+std::vector<int> generatePrimeNumbers(int num_primes = 300,
+                                      int num_threads = 1);
+
+// Like generatePrimeNumbers, but served from the memory-mapped table at
+// cache_path. The file is created or extended only if it holds fewer than
+// num_primes primes. Returns a private copy of the table; to share the
+// page-cached table, read PrimeTableCache::primes() instead.
+std::vector<int> generatePrimeNumbers(int num_primes,
+                                      const std::string &cache_path);
+
+// Compile-time counterpart of generatePrimeNumbers for small fixed counts,
+// e.g. `constexpr auto kPrimes = compileTimePrimeNumbers<300>();`. Same
+// 1-based layout (kPrimes[1] == 2, kPrimes[0] unused); a constexpr table
+// ends up in .rodata and costs no work at startup. Meant for a few thousand
+// primes at most; larger tables exceed the compiler's constexpr step limit.
+template <int NumPrimes>
+constexpr std::array<int, NumPrimes + 1> compileTimePrimeNumbers() {
+  static_assert(NumPrimes >= 1, "need at least one prime");
+  std::array<int, NumPrimes + 1> primes{};
+  primes[1] = 2;
+  int prime_count = 1;
+  for (int candidate = 3; prime_count < NumPrimes; candidate += 2) {
+    bool is_prime = true;
+    for (int i = 2; i <= prime_count && is_prime; i++) {
+      if (primes[i] * primes[i] > candidate) break;
+      is_prime = candidate % primes[i] != 0;
+    }
+    if (is_prime) primes[++prime_count] = candidate;
+  }
+  return primes;
+}
 
 void printPrimeNumbersByLine(const std::vector<int> &primes, int row_offset,
                              int num_primes);
 
 void printPrimeNumbers(std::vector<int> &primes, int num_primes = 300);
+
+// Same output as printPrimeNumbers, but every page is formatted into one
+// reusable character buffer and handed to `out` with a single write.
+void printPrimeNumbersBuffered(const std::vector<int> &primes,
+                               int num_primes = 300,
+                               std::ostream &out = std::cout);
+
+// Same output for a 0-based table of raw primes (table[0] == 2), e.g.
+// PrimeTableCache::primes(), printed straight from the mapping.
+void printPrimeNumbersBuffered(const std::uint32_t *table, int num_primes,
+                               std::ostream &out = std::cout);
@@ -0,0 +1,140 @@
+#include "prime_sieve.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+long long nthPrimeUpperBound(int n) {
+  if (n < 6) return 13;
+  const double kN = n;
+  const double kBound = kN * (std::log(kN) + std::log(std::log(kN)));
+  return std::min<long long>(static_cast<long long>(kBound) + 1, INT_MAX);
+}
+
+std::vector<int> basePrimesUpTo(int limit) {
+  std::vector<int> base_primes;
+  if (limit < 2) return base_primes;
+
+  std::vector<char> composite(limit + 1, 0);
+  for (long long i = 2; i <= limit; i++) {
+    if (composite[i]) continue;
+    base_primes.push_back(static_cast<int>(i));
+    for (long long multiple = i * i; multiple <= limit; multiple += i)
+      composite[multiple] = 1;
+  }
+  return base_primes;
+}
+
+void sieveSegment(long long low, long long high,
+                  const std::vector<int> &base_primes,
+                  std::vector<char> &flags) {
+  const long long kNumOdds = (high - low + 1) / 2;
+  flags.assign(kNumOdds, 1);
+  if (low == 1) flags[0] = 0;  // 1 is not prime
+
+  for (int prime : base_primes) {
+    const long long kPrime = prime;
+    if (kPrime == 2) continue;
+    if (kPrime * kPrime >= high) break;
+
+    // First odd multiple of prime inside [low, high), but never below
+    // prime^2 so that prime itself stays unmarked.
+    long long start =
+        std::max(kPrime * kPrime, (low + kPrime - 1) / kPrime * kPrime);
+    if (start % 2 == 0) start += kPrime;
+
+    for (long long idx = (start - low) / 2; idx < kNumOdds; idx += kPrime)
+      flags[idx] = 0;
+  }
+}
+
+static void checkPrimeCount(int num_primes) {
+  if (num_primes > kMaxPrimeCount)
+    throw std::out_of_range("sieveFirstPrimes: cannot represent " +
+                            std::to_string(num_primes) + " primes as int");
+}
+
+std::vector<int> sieveFirstPrimes(int num_primes) {
+  if (num_primes < 1) return std::vector<int>(1);
+  checkPrimeCount(num_primes);
+
+  const long long kLimit = nthPrimeUpperBound(num_primes);
+  const int kSqrtLimit =
+      static_cast<int>(std::sqrt(static_cast<double>(kLimit))) + 1;
+  const std::vector<int> kBasePrimes = basePrimesUpTo(kSqrtLimit);
+
+  std::vector<int> primes(num_primes + 1);
+  std::vector<char> flags;
+  primes[1] = 2;
+  int prime_count = 1;
+
+  const long long kSegmentSpan = 2LL * kSegmentBytes;
+  for (long long low = 1; low <= kLimit && prime_count < num_primes;
+       low += kSegmentSpan) {
+    const long long kHigh = std::min(low + kSegmentSpan, kLimit + 1);
+    sieveSegment(low, kHigh, kBasePrimes, flags);
+
+    for (std::size_t i = 0; i < flags.size() && prime_count < num_primes; i++) {
+      if (flags[i]) {
+        prime_count++;
+        primes[prime_count] = static_cast<int>(low + 2 * (long long)i);
+      }
+    }
+  }
+  return primes;
+}
+
+// Appends every odd prime in [low, high) to `out`, segment by segment.
+static void sieveRange(long long low, long long high,
+                       const std::vector<int> &base_primes,
+                       std::vector<int> &out) {
+  std::vector<char> flags;
+  const long long kSegmentSpan = 2LL * kSegmentBytes;
+  for (long long seg_low = low; seg_low < high; seg_low += kSegmentSpan) {
+    const long long kSegHigh = std::min(seg_low + kSegmentSpan, high);
+    sieveSegment(seg_low, kSegHigh, base_primes, flags);
+    for (std::size_t i = 0; i < flags.size(); i++)
+      if (flags[i]) out.push_back(static_cast<int>(seg_low + 2 * (long long)i));
+  }
+}
+
+std::vector<int> sieveFirstPrimesParallel(int num_primes, int num_threads) {
+  if (num_primes < 1) return std::vector<int>(1);
+  checkPrimeCount(num_primes);
+  if (num_threads <= 1) return sieveFirstPrimes(num_primes);
+
+  const long long kLimit = nthPrimeUpperBound(num_primes);
+  const int kSqrtLimit =
+      static_cast<int>(std::sqrt(static_cast<double>(kLimit))) + 1;
+  const std::vector<int> kBasePrimes = basePrimesUpTo(kSqrtLimit);
+
+  // Hand out whole segments so every worker keeps its flags in L1.
+  const long long kSegmentSpan = 2LL * kSegmentBytes;
+  const long long kNumSegments = (kLimit + kSegmentSpan - 1) / kSegmentSpan;
+  const int kNumWorkers =
+      static_cast<int>(std::min<long long>(num_threads, kNumSegments));
+
+  std::vector<std::vector<int>> chunks(kNumWorkers);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kNumWorkers; t++) {
+    const long long kLow = 1 + kNumSegments * t / kNumWorkers * kSegmentSpan;
+    const long long kHigh = std::min(
+        1 + kNumSegments * (t + 1) / kNumWorkers * kSegmentSpan, kLimit + 1);
+    workers.emplace_back(sieveRange, kLow, kHigh, std::cref(kBasePrimes),
+                         std::ref(chunks[t]));
+  }
+  for (std::thread &worker : workers) worker.join();
+
+  std::vector<int> primes(num_primes + 1);
+  primes[1] = 2;
+  int prime_count = 1;
+  for (const std::vector<int> &chunk : chunks) {
+    for (std::size_t i = 0; i < chunk.size() && prime_count < num_primes; i++)
+      primes[++prime_count] = chunk[i];
+  }
+  return primes;
+}
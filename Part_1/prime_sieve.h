@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+// Largest count of primes that still fit into an int (pi(2^31 - 1)).
+const int kMaxPrimeCount = 105097565;
+
+// Size of one sieve segment in bytes. Each byte flags one odd number, so a
+// segment covers 2 * kSegmentBytes integers and stays resident in L1d.
+const int kSegmentBytes = 32 * 1024;
+
+// Upper bound for the n-th prime (Rosser/Dusart: p_n < n (ln n + ln ln n)
+// for n >= 6).
+long long nthPrimeUpperBound(int n);
+
+// All primes p <= limit, in ascending order (plain sieve of Eratosthenes).
+std::vector<int> basePrimesUpTo(int limit);
+
+// Sieves the odd numbers in [low, high). `low` must be odd; on return
+// flags[i] is 1 iff low + 2 * i is prime. `base_primes` must contain every
+// odd prime up to sqrt(high).
+void sieveSegment(long long low, long long high,
+                  const std::vector<int> &base_primes,
+                  std::vector<char> &flags);
+
+// The first num_primes primes using a cache-blocked segmented sieve of
+// Eratosthenes. Uses the same 1-based layout as generatePrimeNumbers:
+// result[1] == 2, result[num_primes] is the num_primes-th prime.
+std::vector<int> sieveFirstPrimes(int num_primes);
+
+// Same table as sieveFirstPrimes, but the sieve range is split into
+// num_threads contiguous runs of segments that are sieved concurrently with
+// the shared base primes up to sqrt(limit). The per-thread results are
+// concatenated in order.
+std::vector<int> sieveFirstPrimesParallel(int num_primes, int num_threads);
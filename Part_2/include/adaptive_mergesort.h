@@ -0,0 +1,17 @@
+#ifndef MAPRA_ADAPTIVE_MERGESORT_H_
+#define MAPRA_ADAPTIVE_MERGESORT_H_
+
+#include <vector>
+
+namespace mapra
+{
+
+    // Natural merge sort in the style of TimSort: detects existing ascending
+    // and descending runs, extends short runs with Insertionsort and merges
+    // them with galloping. O(n) on sorted or reverse sorted input,
+    // O(n log n) in the worst case, stable.
+    void AdaptiveMergesort(std::vector<unsigned int> &array);
+
+}
+
+#endif // MAPRA_ADAPTIVE_MERGESORT_H_
@@ -0,0 +1,42 @@
+#ifndef MAPRA_KEY_ARGSORT_H_
+#define MAPRA_KEY_ARGSORT_H_
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility> // for std::move
+#include <vector>
+
+namespace mapra
+{
+
+    // Returns the permutation p that sorts keys, i.e. keys[p[0]] <=
+    // keys[p[1]] <= ..., without moving the keys. Equal keys keep their
+    // input order. Every key is packed with its index into one 64-bit word
+    // (key << 32 | index), so a single LSD radix sort over the words sorts
+    // by key and breaks ties by index. The sorter cannot be chosen: all
+    // other sorters here take 32-bit keys and cannot sort the packed
+    // words. Throws std::length_error for more than 2^32 keys.
+    std::vector<std::uint32_t> Argsort(const std::vector<unsigned int> &keys);
+
+    // Rearranges array to array[p[0]], array[p[1]], ... in one gather
+    // pass; p must be a permutation of 0, ..., n - 1 (e.g. the result of
+    // Argsort). The writes are sequential and every element is moved, not
+    // copied. Throws std::invalid_argument if the sizes differ.
+    template <typename T>
+    void ApplyPermutation(std::vector<T> &array,
+                          const std::vector<std::uint32_t> &permutation)
+    {
+        if (permutation.size() != array.size())
+            throw std::invalid_argument(
+                "ApplyPermutation: permutation and array differ in size");
+
+        std::vector<T> sorted;
+        sorted.reserve(array.size());
+        for (std::uint32_t index : permutation)
+            sorted.push_back(std::move(array[index]));
+        array.swap(sorted);
+    }
+
+}
+
+#endif // MAPRA_KEY_ARGSORT_H_
@@ -0,0 +1,40 @@
+#ifndef MAPRA_EXTERNAL_SORT_H_
+#define MAPRA_EXTERNAL_SORT_H_
+
+#include <cstddef>
+#include <string>
+
+namespace mapra
+{
+
+    // Default memory budget of ExternalSort: 1 GiB.
+    constexpr std::size_t kExternalSortMemory = std::size_t{1} << 30;
+    // Smallest memory budget ExternalSort accepts: 8 KiB.
+    constexpr std::size_t kExternalSortMinMemory = std::size_t{1} << 13;
+
+    // Sorts a binary file of native-endian 32-bit unsigned keys that may be
+    // much larger than the main memory and writes the keys to output_path.
+    //
+    // Phase 1 reads chunks of memory_bytes / 8 keys (the chunk plus the
+    // scratch buffer of RadixSort fill the budget), sorts each with
+    // RadixSort and writes it as a sorted run. Phase 2 merges the runs with
+    // a loser tree. The k read buffers and the write buffer split the
+    // budget evenly; k is chosen so that every buffer gets at least 1 MiB,
+    // but at least 2 runs are merged at a time, so budgets below 3 MiB get
+    // smaller buffers. If there are more than k runs, they are merged in
+    // several passes.
+    //
+    // Runs are stored next to output_path, or in temp_dir if it is not
+    // empty, and are deleted when the sort finishes. Throws
+    // std::invalid_argument if memory_bytes is below kExternalSortMinMemory
+    // or if input_path and output_path name the same file, and
+    // std::runtime_error on I/O errors or if the input size is not a
+    // multiple of 4 bytes.
+    void ExternalSort(const std::string &input_path,
+                      const std::string &output_path,
+                      std::size_t memory_bytes = kExternalSortMemory,
+                      const std::string &temp_dir = "");
+
+}
+
+#endif // MAPRA_EXTERNAL_SORT_H_
@@ -1,6 +1,7 @@
 #ifndef MAPRA_HEAPSORT_H_
 #define MAPRA_HEAPSORT_H_
 
+#include <cstddef>
 #include <vector>
 
 namespace mapra
@@ -8,6 +9,24 @@ namespace mapra
 
     void Heapsort(std::vector<unsigned int> &array);
 
+    // Sorts only the subrange array[lo, hi).
+    void HeapsortRange(std::vector<unsigned int> &array, std::size_t lo,
+                       std::size_t hi);
+
+    // Bottom-up heapsort: sifts down to a leaf along the larger children
+    // with one comparison per level and then climbs back up to the right
+    // position. In place, O(1) extra memory.
+    void BottomUpHeapsort(std::vector<unsigned int> &array);
+
+    // Heapsort on a D-ary max-heap (instantiated for D = 4 and 8). The
+    // children of node i > 0 are a[D * i, D * i + D), so the D siblings
+    // compared in a sift step are one contiguous block of D keys, and the
+    // heap is only log_D(n) levels deep. The blocks are not aligned to
+    // cache lines (the vector's storage is only 16-byte aligned), so for
+    // D = 8 a block may span two lines. In place, O(1) extra memory.
+    template <std::size_t D>
+    void DaryHeapsort(std::vector<unsigned int> &array);
+
 }
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef MAPRA_INSERTIONSORT_H_
 #define MAPRA_INSERTIONSORT_H_
 
+#include <cstddef>
 #include <vector>
 
 namespace mapra
@@ -8,6 +9,10 @@ namespace mapra
 
     void Insertionsort(std::vector<unsigned int> &array);
 
+    // Sorts only the subrange array[lo, hi).
+    void InsertionsortRange(std::vector<unsigned int> &array, std::size_t lo,
+                            std::size_t hi);
+
 }
 
 #endif
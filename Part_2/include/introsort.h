@@ -0,0 +1,16 @@
+#ifndef MAPRA_INTROSORT_H_
+#define MAPRA_INTROSORT_H_
+
+#include <vector>
+
+namespace mapra
+{
+
+    // Quicksort with median-of-3 / ninther pivots that switches to
+    // Heapsort once the recursion gets too deep and to Insertionsort for
+    // small partitions. O(n log n) worst case, O(log n) stack.
+    void Introsort(std::vector<unsigned int> &array);
+
+}
+
+#endif // MAPRA_INTROSORT_H_
@@ -0,0 +1,23 @@
+#ifndef MAPRA_PARALLEL_MERGESORT_H_
+#define MAPRA_PARALLEL_MERGESORT_H_
+
+#include <vector>
+
+namespace mapra
+{
+
+    // Stable merge sort that sorts the two halves on separate threads and
+    // splits every large merge into independent parts (merge path), so the
+    // merges run on all threads as well. Uses one scratch buffer and
+    // alternates between it and the array instead of copying back.
+    // Threads are plain std::thread fork/join, started per split and per
+    // merge (no thread pool); ranges below 2^15 keys stay on one thread.
+    void ParallelMergesort(std::vector<unsigned int> &array,
+                           unsigned int num_threads);
+
+    // Same with std::thread::hardware_concurrency() threads.
+    void ParallelMergesort(std::vector<unsigned int> &array);
+
+}
+
+#endif // MAPRA_PARALLEL_MERGESORT_H_
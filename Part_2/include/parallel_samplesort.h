@@ -0,0 +1,24 @@
+#ifndef MAPRA_PARALLEL_SAMPLESORT_H_
+#define MAPRA_PARALLEL_SAMPLESORT_H_
+
+#include <vector>
+
+namespace mapra
+{
+
+    // Sample sort for many cores. Splitters taken from a sorted random
+    // sample cut the key range into 4 buckets per thread; every thread
+    // classifies and scatters its own block of the array into the buckets,
+    // then the threads sort the buckets with RadixSort. Keys equal to a
+    // splitter get a bucket of their own that needs no sorting, so heavy
+    // duplicates do not unbalance the threads. Not stable; needs a scratch
+    // buffer of n keys and n bucket indices.
+    void ParallelSamplesort(std::vector<unsigned int> &array,
+                            unsigned int num_threads);
+
+    // Same with std::thread::hardware_concurrency() threads.
+    void ParallelSamplesort(std::vector<unsigned int> &array);
+
+}
+
+#endif // MAPRA_PARALLEL_SAMPLESORT_H_
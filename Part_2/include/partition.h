@@ -0,0 +1,31 @@
+#ifndef MAPRA_PARTITION_H_
+#define MAPRA_PARTITION_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mapra
+{
+
+    // Lomuto partition of a[lo, hi] around the pivot a[hi]. Returns the
+    // final pivot position p, with a[lo, p) < a[p] <= a(p, hi]. Only keys
+    // smaller than the pivot are swapped. The default kernel of
+    // QuicksortSimple and QuicksortMedian3.
+    std::size_t LomutoPartition(std::vector<unsigned int> &a, std::size_t lo,
+                                std::size_t hi);
+
+    // Same partition and same p, but the loop body has no data-dependent
+    // branch: every element is swapped and the boundary advances by the
+    // comparison result, so random keys do not cause branch mispredictions.
+    // The unconditional stores make it slower when many keys are equal.
+    // Used by QuicksortSimpleBranchless and QuicksortMedian3Branchless.
+    std::size_t BranchlessLomutoPartition(std::vector<unsigned int> &a,
+                                          std::size_t lo, std::size_t hi);
+
+    // Signature shared by both kernels.
+    using PartitionFunction = std::size_t (*)(std::vector<unsigned int> &,
+                                              std::size_t, std::size_t);
+
+}
+
+#endif // MAPRA_PARTITION_H_
@@ -8,6 +8,10 @@ namespace mapra
 
     void QuicksortMedian3(std::vector<unsigned int> &array);
 
+    // Same, but partitions with the branch-free BranchlessLomutoPartition:
+    // faster on random keys, slower when many keys are equal.
+    void QuicksortMedian3Branchless(std::vector<unsigned int> &array);
+
 }
 
 #endif // MAPRA_QUICKSORT_MEDIAN3_H_
@@ -8,6 +8,10 @@ namespace mapra
 
     void QuicksortSimple(std::vector<unsigned int> &array);
 
+    // Same, but partitions with the branch-free BranchlessLomutoPartition:
+    // faster on random keys, slower when many keys are equal.
+    void QuicksortSimpleBranchless(std::vector<unsigned int> &array);
+
 }
 
 #endif
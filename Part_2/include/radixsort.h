@@ -0,0 +1,15 @@
+#ifndef MAPRA_RADIXSORT_H_
+#define MAPRA_RADIXSORT_H_
+
+#include <vector>
+
+namespace mapra
+{
+
+    // LSD radix sort over the four bytes of each key. Not a comparison
+    // sort: O(n) time, one scratch buffer of n keys.
+    void RadixSort(std::vector<unsigned int> &array);
+
+}
+
+#endif // MAPRA_RADIXSORT_H_
@@ -0,0 +1,32 @@
+#ifndef MAPRA_SORT_SMALL_H_
+#define MAPRA_SORT_SMALL_H_
+
+#include <array>
+#include <cstddef>
+
+namespace mapra
+{
+
+    // Largest n handled by SortSmall.
+    constexpr std::size_t kSortSmallMax = 16;
+
+    // Sorts data[0, n) with a fixed sorting network, n <= kSortSmallMax.
+    // Every comparator is a branch-free min/max pair, so the running time
+    // does not depend on the input order and there are no branch
+    // mispredictions. The networks for n <= 12 and n = 14 .. 16 use the
+    // fewest comparators known. With -DMAPRA_SORT_STATS each comparator
+    // is counted as a comparison and, if it exchanges, as a swap. Throws
+    // std::length_error if n > kSortSmallMax.
+    void SortSmall(unsigned int *data, std::size_t n);
+
+    // Fixed-size batches, e.g. SortSmall(std::array<unsigned int, 8> &).
+    template <std::size_t N>
+    void SortSmall(std::array<unsigned int, N> &batch)
+    {
+        static_assert(N <= kSortSmallMax, "SortSmall: batch too large");
+        SortSmall(batch.data(), N);
+    }
+
+}
+
+#endif // MAPRA_SORT_SMALL_H_
@@ -0,0 +1,94 @@
+#ifndef MAPRA_SORT_STATS_H_
+#define MAPRA_SORT_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace mapra
+{
+
+    // Operation counts of the sorters Bubblesort ... Mergesort. They are
+    // only collected when compiled with -DMAPRA_SORT_STATS; otherwise the
+    // hooks below are empty inline functions that the compiler removes and
+    // all counts stay zero. Counts are kept per thread.
+    struct SortStats
+    {
+        std::uint64_t comparisons = 0;
+        std::uint64_t moves = 0; // element writes outside of swaps
+        std::uint64_t swaps = 0;
+        std::size_t max_depth = 0; // deepest recursion level
+        std::size_t depth = 0;     // current recursion level
+    };
+
+#ifdef MAPRA_SORT_STATS
+    inline constexpr bool kSortStatsEnabled = true;
+#else
+    inline constexpr bool kSortStatsEnabled = false;
+#endif
+
+    inline SortStats &CurrentSortStats()
+    {
+        static thread_local SortStats stats;
+        return stats;
+    }
+
+    inline void ResetSortStats() { CurrentSortStats() = SortStats(); }
+
+    // "cmp=... moves=... swaps=... depth=..." or "" if stats are disabled.
+    inline std::string FormatSortStats()
+    {
+        if (!kSortStatsEnabled)
+            return "";
+        const SortStats &stats = CurrentSortStats();
+        return "cmp=" + std::to_string(stats.comparisons) +
+               " moves=" + std::to_string(stats.moves) +
+               " swaps=" + std::to_string(stats.swaps) +
+               " depth=" + std::to_string(stats.max_depth);
+    }
+
+    // Hooks for the sorters. Wrap a key comparison: if (CountCompare(a < b))
+    inline bool CountCompare(bool result)
+    {
+        if (kSortStatsEnabled)
+            ++CurrentSortStats().comparisons;
+        return result;
+    }
+
+    inline void CountMove()
+    {
+        if (kSortStatsEnabled)
+            ++CurrentSortStats().moves;
+    }
+
+    inline void CountSwap()
+    {
+        if (kSortStatsEnabled)
+            ++CurrentSortStats().swaps;
+    }
+
+    // Tracks the recursion depth while in scope.
+    class DepthCounter
+    {
+    public:
+        DepthCounter()
+        {
+            if (kSortStatsEnabled)
+            {
+                SortStats &stats = CurrentSortStats();
+                if (++stats.depth > stats.max_depth)
+                    stats.max_depth = stats.depth;
+            }
+        }
+        DepthCounter(const DepthCounter &) = delete;
+        DepthCounter &operator=(const DepthCounter &) = delete;
+        ~DepthCounter()
+        {
+            if (kSortStatsEnabled)
+                --CurrentSortStats().depth;
+        }
+    };
+
+} // namespace mapra
+
+#endif // MAPRA_SORT_STATS_H_
@@ -0,0 +1,215 @@
+#include "../include/adaptive_mergesort.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "../include/insertionsort.h"
+#include "../include/sort_stats.h"
+
+namespace mapra
+{
+
+  // After this many consecutive wins of one run the merge starts galloping.
+  static const std::size_t kMinGallop = 7;
+
+  struct Run
+  {
+    std::size_t base;
+    std::size_t length;
+  };
+
+  // Minimal run length: n / minrun is close to, but not above, a power of
+  // two, so the final merges stay balanced.
+  static std::size_t MinRunLength(std::size_t n)
+  {
+    std::size_t extra = 0;
+    while (n >= 64)
+    {
+      extra |= n & 1;
+      n >>= 1;
+    }
+    return n + extra;
+  }
+
+  // Length of the run starting at lo. A strictly descending run is
+  // reversed in place (strictness keeps the sort stable).
+  static std::size_t CountRun(std::vector<unsigned int> &a, std::size_t lo,
+                              std::size_t hi)
+  {
+    std::size_t end = lo + 1;
+    if (end == hi)
+      return 1;
+    if (CountCompare(a[end] < a[lo]))
+    {
+      while (end + 1 < hi && CountCompare(a[end + 1] < a[end]))
+        ++end;
+      std::reverse(a.begin() + lo, a.begin() + end + 1);
+    }
+    else
+    {
+      while (end + 1 < hi && CountCompare(a[end + 1] >= a[end]))
+        ++end;
+    }
+    return end + 1 - lo;
+  }
+
+  // Number of leading elements of x[0, n) that are <= key. Exponential
+  // search first, so keys near the front are found in O(log distance).
+  static std::size_t GallopUpper(const unsigned int *x, std::size_t n,
+                                 unsigned int key)
+  {
+    std::size_t hi = 1;
+    while (hi < n && CountCompare(x[hi - 1] <= key))
+      hi *= 2;
+    return std::upper_bound(x + hi / 2, x + std::min(hi, n), key,
+                            [](unsigned int k, unsigned int y)
+                            { return CountCompare(k < y); }) -
+           x;
+  }
+
+  // Number of leading elements of x[0, n) that are < key.
+  static std::size_t GallopLower(const unsigned int *x, std::size_t n,
+                                 unsigned int key)
+  {
+    std::size_t hi = 1;
+    while (hi < n && CountCompare(x[hi - 1] < key))
+      hi *= 2;
+    return std::lower_bound(x + hi / 2, x + std::min(hi, n), key,
+                            [](unsigned int y, unsigned int k)
+                            { return CountCompare(y < k); }) -
+           x;
+  }
+
+  // Merges the adjacent sorted runs a[lo, mid) and a[mid, hi).
+  static void MergeRuns(std::vector<unsigned int> &a, std::size_t lo,
+                        std::size_t mid, std::size_t hi,
+                        std::vector<unsigned int> &tmp)
+  {
+    unsigned int *data = a.data();
+    // Keys of the left run that are <= the first right key are in place,
+    // and so are keys of the right run that are >= the last left key.
+    lo += GallopUpper(data + lo, mid - lo, data[mid]);
+    if (lo == mid)
+      return;
+    hi = mid + GallopLower(data + mid, hi - mid, data[mid - 1]);
+
+    const std::size_t left_length = mid - lo;
+    if (tmp.size() < left_length)
+      tmp.resize(left_length);
+    std::copy(data + lo, data + mid, tmp.begin());
+
+    const unsigned int *left = tmp.data();
+    std::size_t i = 0;
+    std::size_t j = mid;
+    std::size_t k = lo;
+    std::size_t left_wins = 0;
+    std::size_t right_wins = 0;
+    while (i < left_length && j < hi)
+    {
+      if (CountCompare(data[j] < left[i]))
+      {
+        data[k++] = data[j++];
+        ++right_wins;
+        left_wins = 0;
+      }
+      else
+      {
+        data[k++] = left[i++];
+        ++left_wins;
+        right_wins = 0;
+      }
+      if (i == left_length || j == hi)
+        break;
+
+      if (left_wins >= kMinGallop)
+      {
+        const std::size_t count =
+            GallopUpper(left + i, left_length - i, data[j]);
+        std::copy(left + i, left + i + count, data + k);
+        i += count;
+        k += count;
+        left_wins = 0;
+      }
+      else if (right_wins >= kMinGallop)
+      {
+        const std::size_t count = GallopLower(data + j, hi - j, left[i]);
+        std::copy(data + j, data + j + count, data + k); // k < j
+        j += count;
+        k += count;
+        right_wins = 0;
+      }
+    }
+    // Whatever is left of the right run is already in place.
+    std::copy(left + i, left + left_length, data + k);
+  }
+
+  static void MergeAt(std::vector<unsigned int> &a, std::vector<Run> &runs,
+                      std::size_t n, std::vector<unsigned int> &tmp)
+  {
+    Run &left = runs[n];
+    const Run &right = runs[n + 1];
+    MergeRuns(a, left.base, right.base, right.base + right.length, tmp);
+    left.length += right.length;
+    runs.erase(runs.begin() + n + 1);
+  }
+
+  // Restores the run length invariants of the (corrected) TimSort stack,
+  // which bound the stack height by O(log n).
+  static void MergeCollapse(std::vector<unsigned int> &a,
+                            std::vector<Run> &runs,
+                            std::vector<unsigned int> &tmp)
+  {
+    while (runs.size() > 1)
+    {
+      std::size_t n = runs.size() - 2;
+      if ((n > 0 &&
+           runs[n - 1].length <= runs[n].length + runs[n + 1].length) ||
+          (n > 1 &&
+           runs[n - 2].length <= runs[n - 1].length + runs[n].length))
+      {
+        if (runs[n - 1].length < runs[n + 1].length)
+          --n;
+      }
+      else if (runs[n].length > runs[n + 1].length)
+      {
+        break;
+      }
+      MergeAt(a, runs, n, tmp);
+    }
+  }
+
+  void AdaptiveMergesort(std::vector<unsigned int> &array)
+  {
+    const std::size_t n = array.size();
+    if (n < 2)
+      return;
+
+    const std::size_t min_run = MinRunLength(n);
+    std::vector<Run> runs;
+    std::vector<unsigned int> tmp;
+    std::size_t lo = 0;
+    while (lo < n)
+    {
+      std::size_t length = CountRun(array, lo, n);
+      if (length < min_run)
+      {
+        // Extend short runs; the sorted prefix makes this cheap.
+        const std::size_t forced = std::min(min_run, n - lo);
+        InsertionsortRange(array, lo, lo + forced);
+        length = forced;
+      }
+      runs.push_back({lo, length});
+      MergeCollapse(array, runs, tmp);
+      lo += length;
+    }
+
+    while (runs.size() > 1)
+    {
+      std::size_t m = runs.size() - 2;
+      if (m > 0 && runs[m - 1].length < runs[m + 1].length)
+        --m;
+      MergeAt(array, runs, m, tmp);
+    }
+  }
+
+} // namespace mapra
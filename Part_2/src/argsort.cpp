@@ -0,0 +1,75 @@
+#include "../include/argsort.h"
+
+#include <cstddef>
+#include <utility> // for std::swap
+
+namespace mapra
+{
+
+  static const unsigned int kDigitBits = 8;
+  static const std::size_t kNumBuckets = std::size_t{1} << kDigitBits;
+  static const unsigned int kNumPasses = 64 / kDigitBits;
+
+  // RadixSort for 64-bit words: LSD over the eight bytes, passes whose
+  // digit is the same in every word are skipped (e.g. the upper index
+  // bytes of small inputs).
+  static void RadixSort64(std::vector<std::uint64_t> &array)
+  {
+    const std::size_t n = array.size();
+    if (n < 2)
+      return;
+
+    std::vector<std::size_t> counts(kNumPasses * kNumBuckets, 0);
+    for (std::uint64_t word : array)
+    {
+      for (unsigned int pass = 0; pass < kNumPasses; ++pass)
+        ++counts[pass * kNumBuckets +
+                 ((word >> (pass * kDigitBits)) & (kNumBuckets - 1))];
+    }
+
+    std::vector<std::uint64_t> scratch(n);
+    std::vector<std::uint64_t> *from = &array;
+    std::vector<std::uint64_t> *to = &scratch;
+    for (unsigned int pass = 0; pass < kNumPasses; ++pass)
+    {
+      std::size_t *count = &counts[pass * kNumBuckets];
+      const unsigned int shift = pass * kDigitBits;
+
+      if (count[((*from)[0] >> shift) & (kNumBuckets - 1)] == n)
+        continue;
+
+      std::size_t offset = 0;
+      for (std::size_t bucket = 0; bucket < kNumBuckets; ++bucket)
+      {
+        const std::size_t size = count[bucket];
+        count[bucket] = offset;
+        offset += size;
+      }
+
+      for (std::uint64_t word : *from)
+        (*to)[count[(word >> shift) & (kNumBuckets - 1)]++] = word;
+      std::swap(from, to);
+    }
+
+    if (from != &array)
+      array.swap(scratch);
+  }
+
+  std::vector<std::uint32_t> Argsort(const std::vector<unsigned int> &keys)
+  {
+    // The indices 0, ..., n - 1 have to fit into the lower 32 bits.
+    if (keys.size() > std::uint64_t{1} << 32)
+      throw std::length_error("Argsort: more than 2^32 keys");
+
+    std::vector<std::uint64_t> words(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      words[i] = std::uint64_t{keys[i]} << 32 | i;
+    RadixSort64(words);
+
+    std::vector<std::uint32_t> permutation(words.size());
+    for (std::size_t i = 0; i < words.size(); ++i)
+      permutation[i] = static_cast<std::uint32_t>(words[i]);
+    return permutation;
+  }
+
+} // namespace mapra
@@ -2,6 +2,8 @@
 
 #include <utility> // for std::swap
 
+#include "../include/sort_stats.h"
+
 namespace mapra
 {
 
@@ -14,9 +16,10 @@ namespace mapra
       bool swapped = false;
       for (std::size_t i = 0; i + 1 < end; ++i)
       {
-        if (array[i] > array[i + 1])
+        if (CountCompare(array[i] > array[i + 1]))
         {
           std::swap(array[i], array[i + 1]);
+          CountSwap();
           swapped = true;
         }
       }
@@ -0,0 +1,320 @@
+#include "../include/external_sort.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility> // for std::swap
+#include <vector>
+
+#include "../include/radixsort.h"
+
+namespace mapra
+{
+
+  // Smallest I/O buffer per run during a merge. Bounds the fan-in of a
+  // merge pass, so that the reads stay large and sequential.
+  static const std::size_t kMinBufferBytes = std::size_t{1} << 20;
+  // Head of an exhausted run in the loser tree, larger than every key.
+  static const std::uint64_t kExhausted =
+      std::numeric_limits<std::uint64_t>::max();
+
+  static std::runtime_error IoError(const std::string &what,
+                                    const std::string &path)
+  {
+    return std::runtime_error("ExternalSort: cannot " + what + " " + path +
+                              ": " + std::strerror(errno));
+  }
+
+  namespace
+  {
+
+    struct FileCloser
+    {
+      void operator()(std::FILE *file) const { std::fclose(file); }
+    };
+    using File = std::unique_ptr<std::FILE, FileCloser>;
+
+    // Opens an unbuffered stdio file; the callers buffer on their own.
+    File Open(const std::string &path, const char *mode)
+    {
+      File file(std::fopen(path.c_str(), mode));
+      if (!file)
+        throw IoError("open", path);
+      std::setvbuf(file.get(), nullptr, _IONBF, 0);
+      return file;
+    }
+
+    void ReadKeys(std::FILE *file, const std::string &path,
+                  unsigned int *keys, std::size_t count)
+    {
+      if (std::fread(keys, sizeof(unsigned int), count, file) != count)
+        throw IoError("read", path);
+    }
+
+    void WriteKeys(std::FILE *file, const std::string &path,
+                   const unsigned int *keys, std::size_t count)
+    {
+      if (std::fwrite(keys, sizeof(unsigned int), count, file) != count)
+        throw IoError("write", path);
+    }
+
+    void Close(File &file, const std::string &path)
+    {
+      if (std::fclose(file.release()) != 0)
+        throw IoError("write", path);
+    }
+
+    // Reads a sorted run sequentially in blocks of buffer_keys keys.
+    class RunReader
+    {
+    public:
+      RunReader(const std::string &path, std::size_t buffer_keys)
+          : path_(path), file_(Open(path, "rb")), buffer_(buffer_keys)
+      {
+      }
+
+      // The next key of the run, or kExhausted after the last one.
+      std::uint64_t Next()
+      {
+        if (pos_ == size_)
+        {
+          size_ = std::fread(buffer_.data(), sizeof(unsigned int),
+                             buffer_.size(), file_.get());
+          pos_ = 0;
+          if (size_ == 0)
+          {
+            if (std::ferror(file_.get()))
+              throw IoError("read", path_);
+            return kExhausted;
+          }
+        }
+        return buffer_[pos_++];
+      }
+
+    private:
+      std::string path_;
+      File file_;
+      std::vector<unsigned int> buffer_;
+      std::size_t pos_ = 0;
+      std::size_t size_ = 0;
+    };
+
+    // Tournament tree over the heads of k runs. The inner nodes
+    // tree_[1, k) hold the loser of the match played there, tree_[0] the
+    // overall winner, i.e. the run with the smallest head. Leaf i is node
+    // k + i, so after the winner has advanced, replaying its path to the
+    // root takes ceil(log2 k) comparisons, one per level and without the
+    // sibling comparison a binary heap needs.
+    class LoserTree
+    {
+    public:
+      explicit LoserTree(const std::vector<std::uint64_t> &heads)
+          : heads_(heads), tree_(heads.size())
+      {
+        const std::size_t k = heads.size();
+        std::vector<std::size_t> winner(2 * k);
+        for (std::size_t i = 0; i < k; ++i)
+          winner[k + i] = i;
+        for (std::size_t node = k - 1; node > 0; --node)
+        {
+          std::size_t a = winner[2 * node];
+          std::size_t b = winner[2 * node + 1];
+          if (heads_[b] < heads_[a])
+            std::swap(a, b);
+          winner[node] = a;
+          tree_[node] = b;
+        }
+        tree_[0] = k > 1 ? winner[1] : 0;
+      }
+
+      std::size_t Winner() const { return tree_[0]; }
+
+      // Call after the head of run `leaf` (the last winner) has changed.
+      void Replay(std::size_t leaf)
+      {
+        std::size_t winner = leaf;
+        for (std::size_t node = (leaf + tree_.size()) / 2; node > 0;
+             node /= 2)
+        {
+          if (heads_[tree_[node]] < heads_[winner])
+            std::swap(tree_[node], winner);
+        }
+        tree_[0] = winner;
+      }
+
+    private:
+      const std::vector<std::uint64_t> &heads_;
+      std::vector<std::size_t> tree_;
+    };
+
+    // Deletes the run files that are still left when it goes out of scope,
+    // also if the sort failed.
+    class RunFiles
+    {
+    public:
+      explicit RunFiles(const std::string &prefix) : prefix_(prefix) {}
+      RunFiles(const RunFiles &) = delete;
+      RunFiles &operator=(const RunFiles &) = delete;
+      ~RunFiles()
+      {
+        for (const std::string &path : paths_)
+          std::remove(path.c_str());
+      }
+
+      // Path for a new run file.
+      std::string Create()
+      {
+        paths_.push_back(prefix_ + ".run" + std::to_string(next_++));
+        return paths_.back();
+      }
+
+      void Remove(const std::string &path)
+      {
+        std::remove(path.c_str());
+        paths_.erase(std::find(paths_.begin(), paths_.end(), path));
+      }
+
+    private:
+      std::string prefix_;
+      std::vector<std::string> paths_;
+      std::size_t next_ = 0;
+    };
+
+  } // namespace
+
+  // k-way merge of the sorted files `runs` into output_path with k + 1
+  // buffers that share memory_bytes.
+  static void MergeRuns(const std::vector<std::string> &runs,
+                        const std::string &output_path,
+                        std::size_t memory_bytes)
+  {
+    const std::size_t k = runs.size();
+    const std::size_t buffer_keys =
+        memory_bytes / (k + 1) / sizeof(unsigned int);
+
+    std::vector<RunReader> readers;
+    readers.reserve(k);
+    std::vector<std::uint64_t> heads(k);
+    for (std::size_t i = 0; i < k; ++i)
+    {
+      readers.emplace_back(runs[i], buffer_keys);
+      heads[i] = readers[i].Next();
+    }
+    LoserTree tree(heads);
+
+    File out = Open(output_path, "wb");
+    std::vector<unsigned int> buffer(buffer_keys);
+    std::size_t size = 0;
+    while (true)
+    {
+      const std::size_t winner = tree.Winner();
+      if (heads[winner] == kExhausted)
+        break;
+      buffer[size++] = static_cast<unsigned int>(heads[winner]);
+      if (size == buffer.size())
+      {
+        WriteKeys(out.get(), output_path, buffer.data(), size);
+        size = 0;
+      }
+      heads[winner] = readers[winner].Next();
+      tree.Replay(winner);
+    }
+    WriteKeys(out.get(), output_path, buffer.data(), size);
+    Close(out, output_path);
+  }
+
+  void ExternalSort(const std::string &input_path,
+                    const std::string &output_path, std::size_t memory_bytes,
+                    const std::string &temp_dir)
+  {
+    if (memory_bytes < kExternalSortMinMemory)
+      throw std::invalid_argument("ExternalSort: memory budget below " +
+                                  std::to_string(kExternalSortMinMemory) +
+                                  " bytes");
+    std::error_code error;
+    // Writing the output would truncate the input before it is read.
+    if (std::filesystem::equivalent(input_path, output_path, error))
+      throw std::invalid_argument("ExternalSort: " + output_path +
+                                  " is the input file");
+    const std::uintmax_t input_bytes =
+        std::filesystem::file_size(input_path, error);
+    if (error)
+      throw std::runtime_error("ExternalSort: cannot open " + input_path +
+                               ": " + error.message());
+    if (input_bytes % sizeof(unsigned int) != 0)
+      throw std::runtime_error("ExternalSort: size of " + input_path +
+                               " is not a multiple of 4 bytes");
+
+    std::uintmax_t remaining = input_bytes / sizeof(unsigned int);
+    const std::size_t chunk_keys = memory_bytes / (2 * sizeof(unsigned int));
+    File in = Open(input_path, "rb");
+    std::vector<unsigned int> chunk;
+
+    // Everything fits into memory: no runs needed.
+    if (remaining <= chunk_keys)
+    {
+      chunk.resize(remaining);
+      ReadKeys(in.get(), input_path, chunk.data(), chunk.size());
+      RadixSort(chunk);
+      File out = Open(output_path, "wb");
+      WriteKeys(out.get(), output_path, chunk.data(), chunk.size());
+      Close(out, output_path);
+      return;
+    }
+
+    RunFiles files(temp_dir.empty()
+                       ? output_path
+                       : (std::filesystem::path(temp_dir) /
+                          std::filesystem::path(output_path).filename())
+                             .string());
+
+    // Phase 1: sorted runs of chunk_keys keys.
+    std::vector<std::string> runs;
+    while (remaining > 0)
+    {
+      chunk.resize(std::min<std::uintmax_t>(remaining, chunk_keys));
+      ReadKeys(in.get(), input_path, chunk.data(), chunk.size());
+      remaining -= chunk.size();
+      RadixSort(chunk);
+
+      runs.push_back(files.Create());
+      File out = Open(runs.back(), "wb");
+      WriteKeys(out.get(), runs.back(), chunk.data(), chunk.size());
+      Close(out, runs.back());
+    }
+    in.reset();
+    std::vector<unsigned int>().swap(chunk); // the merge needs the memory
+
+    // Phase 2: merge passes of at most fan_in runs each. Below 3 MiB the
+    // fan-in stays 2 and MergeRuns shrinks the buffers to the budget.
+    const std::size_t fan_in =
+        std::max<std::size_t>(memory_bytes / kMinBufferBytes, 3) - 1;
+    while (runs.size() > fan_in)
+    {
+      std::vector<std::string> merged;
+      for (std::size_t i = 0; i < runs.size(); i += fan_in)
+      {
+        const std::vector<std::string> group(
+            runs.begin() + i, runs.begin() + std::min(i + fan_in, runs.size()));
+        if (group.size() == 1)
+        {
+          merged.push_back(group[0]);
+          continue;
+        }
+        merged.push_back(files.Create());
+        MergeRuns(group, merged.back(), memory_bytes);
+        for (const std::string &run : group)
+          files.Remove(run);
+      }
+      runs.swap(merged);
+    }
+    MergeRuns(runs, output_path, memory_bytes);
+  }
+
+} // namespace mapra
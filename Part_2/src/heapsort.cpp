@@ -1,14 +1,18 @@
 #include "../include/heapsort.h"
 
+#include <algorithm>
 #include <utility> // for std::swap
 #include <vector>
 
+#include "../include/sort_stats.h"
+
 namespace mapra
 {
 
-  // Sift‐down the node at index `root` in a heap of size `count`.
-  static void Heapify(std::vector<unsigned int> &a, std::size_t root,
-                      std::size_t count)
+  // Sift‐down the node at index `root` in a heap of size `count` that is
+  // stored in a[base, base + count).
+  static void Heapify(std::vector<unsigned int> &a, std::size_t base,
+                      std::size_t root, std::size_t count)
   {
     while (true)
     {
@@ -16,10 +20,14 @@ namespace mapra
       if (left >= count)
         break;
       std::size_t right = left + 1;
-      std::size_t child = (right < count && a[right] > a[left]) ? right : left;
-      if (a[child] > a[root])
+      std::size_t child =
+          (right < count && CountCompare(a[base + right] > a[base + left]))
+              ? right
+              : left;
+      if (CountCompare(a[base + child] > a[base + root]))
       {
-        std::swap(a[root], a[child]);
+        std::swap(a[base + root], a[base + child]);
+        CountSwap();
         root = child;
       }
       else
@@ -29,20 +37,126 @@ namespace mapra
     }
   }
 
-  void Heapsort(std::vector<unsigned int> &array)
+  void HeapsortRange(std::vector<unsigned int> &array, std::size_t lo,
+                     std::size_t hi)
   {
-    const std::size_t n = array.size();
+    const std::size_t n = hi - lo;
     // Build max‐heap
     for (std::size_t start = (n / 2); start-- > 0;)
     {
-      Heapify(array, start, n);
+      Heapify(array, lo, start, n);
     }
     // Extract elements one by one
     for (std::size_t end = n; end > 1; --end)
+    {
+      std::swap(array[lo], array[lo + end - 1]);
+      CountSwap();
+      Heapify(array, lo, 0, end - 1);
+    }
+  }
+
+  void Heapsort(std::vector<unsigned int> &array)
+  {
+    HeapsortRange(array, 0, array.size());
+  }
+
+  // Bottom-up sift of a[root] in a heap of size `count`: move the hole
+  // down to a leaf along the larger children (one comparison per level),
+  // then let the sifted value climb back up from there. The value almost
+  // always belongs close to the leaf, so the climb is short.
+  static void BottomUpSift(std::vector<unsigned int> &a, std::size_t root,
+                           std::size_t count)
+  {
+    const unsigned int value = a[root];
+    std::size_t j = root;
+    std::size_t child;
+    while ((child = 2 * j + 1) + 1 < count)
+    {
+      child += a[child + 1] > a[child]; // no branch on the key order
+      a[j] = a[child];
+      j = child;
+    }
+    if (child < count) // single child at the bottom
+    {
+      a[j] = a[child];
+      j = child;
+    }
+    while (j > root)
+    {
+      const std::size_t parent = (j - 1) / 2;
+      if (a[parent] >= value)
+        break;
+      a[j] = a[parent];
+      j = parent;
+    }
+    a[j] = value;
+  }
+
+  void BottomUpHeapsort(std::vector<unsigned int> &array)
+  {
+    const std::size_t n = array.size();
+    for (std::size_t start = (n / 2); start-- > 0;)
+    {
+      BottomUpSift(array, start, n);
+    }
+    for (std::size_t end = n; end > 1; --end)
+    {
+      std::swap(array[0], array[end - 1]);
+      BottomUpSift(array, 0, end - 1);
+    }
+  }
+
+  // Sift-down in a D-ary heap of size `count`. The root has the D - 1
+  // children a[1, D), every other node i has a[D * i, D * i + D), so each
+  // group of siblings starts at a multiple of D. Moves a hole instead of
+  // swapping.
+  template <std::size_t D>
+  static void DarySift(std::vector<unsigned int> &a, std::size_t root,
+                       std::size_t count)
+  {
+    const unsigned int value = a[root];
+    while (true)
+    {
+      const std::size_t first = root == 0 ? 1 : D * root;
+      if (first >= count)
+        break;
+      const std::size_t last = std::min(D * root + D, count);
+      std::size_t best = first;
+      unsigned int best_value = a[first];
+      for (std::size_t c = first + 1; c < last; ++c)
+      {
+        const bool larger = a[c] > best_value;
+        best = larger ? c : best;
+        best_value = larger ? a[c] : best_value;
+      }
+      if (best_value <= value)
+        break;
+      a[root] = best_value;
+      root = best;
+    }
+    a[root] = value;
+  }
+
+  template <std::size_t D>
+  void DaryHeapsort(std::vector<unsigned int> &array)
+  {
+    const std::size_t n = array.size();
+    if (n < 2)
+      return;
+    // The parent of node j > 0 is j / D.
+    for (std::size_t start = (n - 1) / D + 1; start-- > 0;)
+    {
+      DarySift<D>(array, start, n);
+    }
+    for (std::size_t end = n; end > 1; --end)
     {
       std::swap(array[0], array[end - 1]);
-      Heapify(array, 0, end - 1);
+      DarySift<D>(array, 0, end - 1);
     }
   }
 
+  // Explicit template instantiations
+  template void DaryHeapsort<4>(std::vector<unsigned int> &);
+  template void DaryHeapsort<8>(std::vector<unsigned int> &);
+
 } // namespace mapra
@@ -1,23 +1,32 @@
 #include "../include/insertionsort.h"
 
+#include "../include/sort_stats.h"
+
 namespace mapra
 {
 
-  void Insertionsort(std::vector<unsigned int> &array)
+  void InsertionsortRange(std::vector<unsigned int> &array, std::size_t lo,
+                          std::size_t hi)
   {
-    const std::size_t n = array.size();
-    for (std::size_t i = 1; i < n; ++i)
+    for (std::size_t i = lo + 1; i < hi; ++i)
     {
       unsigned int pivotValue = array[i];
       std::size_t j = i;
       // Shift larger elements rightward
-      while (j > 0 && array[j - 1] > pivotValue)
+      while (j > lo && CountCompare(array[j - 1] > pivotValue))
       {
         array[j] = array[j - 1];
+        CountMove();
         --j;
       }
       array[j] = pivotValue;
+      CountMove();
     }
   }
 
+  void Insertionsort(std::vector<unsigned int> &array)
+  {
+    InsertionsortRange(array, 0, array.size());
+  }
+
 } // namespace mapra
@@ -0,0 +1,109 @@
+#include "../include/introsort.h"
+
+#include <utility> // for std::swap
+
+#include "../include/heapsort.h"
+#include "../include/insertionsort.h"
+#include "../include/sort_stats.h"
+
+namespace mapra
+{
+
+  // Partitions of at most this many elements are left to Insertionsort.
+  static const std::size_t kInsertionThreshold = 16;
+  // From this size on the pivot is the ninther (median of three medians).
+  static const std::size_t kNintherThreshold = 128;
+
+  static std::size_t Median3(const std::vector<unsigned int> &a, std::size_t i,
+                             std::size_t j, std::size_t k)
+  {
+    if (a[i] < a[j])
+    {
+      if (a[j] < a[k])
+        return j;
+      return a[i] < a[k] ? k : i;
+    }
+    if (a[i] < a[k])
+      return i;
+    return a[j] < a[k] ? k : j;
+  }
+
+  static std::size_t ChoosePivot(const std::vector<unsigned int> &a,
+                                 std::size_t lo, std::size_t hi)
+  {
+    const std::size_t n = hi - lo;
+    const std::size_t mid = lo + n / 2;
+    if (n < kNintherThreshold)
+      return Median3(a, lo, mid, hi - 1);
+
+    const std::size_t step = n / 8;
+    return Median3(a, Median3(a, lo, lo + step, lo + 2 * step),
+                   Median3(a, mid - step, mid, mid + step),
+                   Median3(a, hi - 1 - 2 * step, hi - 1 - step, hi - 1));
+  }
+
+  // Hoare partition of a[lo, hi) around a[pivot]. Returns the final pivot
+  // position p with a[lo, p) <= a[p] <= a[p + 1, hi). Both scans stop at
+  // keys equal to the pivot, so runs of duplicates are split evenly.
+  static std::size_t Partition(std::vector<unsigned int> &a, std::size_t lo,
+                               std::size_t hi, std::size_t pivot)
+  {
+    std::swap(a[lo], a[pivot]);
+    const unsigned int value = a[lo];
+    std::size_t i = lo;
+    std::size_t j = hi;
+    while (true)
+    {
+      do
+        ++i;
+      while (i < hi && a[i] < value);
+      do
+        --j;
+      while (a[j] > value); // stops at a[lo] at the latest
+      if (i >= j)
+        break;
+      std::swap(a[i], a[j]);
+    }
+    std::swap(a[lo], a[j]);
+    return j;
+  }
+
+  static void IntroLoop(std::vector<unsigned int> &a, std::size_t lo,
+                        std::size_t hi, std::size_t depth_limit)
+  {
+    DepthCounter depth;
+    while (hi - lo > kInsertionThreshold)
+    {
+      if (depth_limit == 0)
+      {
+        HeapsortRange(a, lo, hi);
+        return;
+      }
+      --depth_limit;
+
+      std::size_t p = Partition(a, lo, hi, ChoosePivot(a, lo, hi));
+      // Recurse into the smaller side only and loop on the larger one.
+      if (p - lo < hi - p - 1)
+      {
+        IntroLoop(a, lo, p, depth_limit);
+        lo = p + 1;
+      }
+      else
+      {
+        IntroLoop(a, p + 1, hi, depth_limit);
+        hi = p;
+      }
+    }
+    InsertionsortRange(a, lo, hi);
+  }
+
+  void Introsort(std::vector<unsigned int> &array)
+  {
+    const std::size_t n = array.size();
+    std::size_t depth_limit = 0;
+    for (std::size_t m = n; m > 1; m /= 2)
+      depth_limit += 2; // 2 * floor(log2(n))
+    IntroLoop(array, 0, n, depth_limit);
+  }
+
+} // namespace mapra
@@ -2,6 +2,9 @@
 
 #include <vector>
 
+#include "../include/sort_small.h"
+#include "../include/sort_stats.h"
+
 namespace mapra
 {
 
@@ -11,23 +14,35 @@ namespace mapra
     std::size_t i = lo, j = mid, k = lo;
     while (i < mid && j < hi)
     {
-      tmp[k++] = (a[i] <= a[j] ? a[i++] : a[j++]);
+      tmp[k++] = (CountCompare(a[i] <= a[j]) ? a[i++] : a[j++]);
+      CountMove();
     }
     while (i < mid)
+    {
       tmp[k++] = a[i++];
+      CountMove();
+    }
     while (j < hi)
+    {
       tmp[k++] = a[j++];
+      CountMove();
+    }
     for (std::size_t x = lo; x < hi; ++x)
     {
       a[x] = tmp[x];
+      CountMove();
     }
   }
 
   static void MS(std::vector<unsigned int> &a, std::size_t lo, std::size_t hi,
                  std::vector<unsigned int> &tmp)
   {
-    if (hi - lo <= 1)
+    DepthCounter depth;
+    if (hi - lo <= kSortSmallMax)
+    {
+      SortSmall(a.data() + lo, hi - lo);
       return;
+    }
     std::size_t mid = lo + (hi - lo) / 2;
     MS(a, lo, mid, tmp);
     MS(a, mid, hi, tmp);
@@ -0,0 +1,135 @@
+#include "../include/parallel_mergesort.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "../include/insertionsort.h"
+
+namespace mapra
+{
+
+  // Ranges up to this size are sorted by Insertionsort.
+  static const std::size_t kInsertionThreshold = 16;
+  // Ranges below this size are never split across threads.
+  static const std::size_t kParallelCutoff = std::size_t{1} << 15;
+
+  // Co-rank of output position k when merging a[0, na) and b[0, nb):
+  // the number i of elements taken from a, so that the first k outputs are
+  // a[0, i) and b[0, k - i). Ties go to a, which keeps the merge stable.
+  static std::size_t CoRank(const unsigned int *a, std::size_t na,
+                            const unsigned int *b, std::size_t nb,
+                            std::size_t k)
+  {
+    std::size_t lo = k > nb ? k - nb : 0;
+    std::size_t hi = std::min(k, na);
+    while (lo < hi)
+    {
+      const std::size_t i = lo + (hi - lo) / 2;
+      if (a[i] <= b[k - i - 1])
+        lo = i + 1;
+      else
+        hi = i;
+    }
+    return lo;
+  }
+
+  static void MergeInto(const unsigned int *a, std::size_t na,
+                        const unsigned int *b, std::size_t nb,
+                        unsigned int *out)
+  {
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+      out[k++] = (a[i] <= b[j] ? a[i++] : b[j++]);
+    while (i < na)
+      out[k++] = a[i++];
+    while (j < nb)
+      out[k++] = b[j++];
+  }
+
+  // Merges src[lo, mid) and src[mid, hi) into dst[lo, hi), cutting the
+  // output into num_threads equal parts that are merged concurrently.
+  static void ParallelMerge(const std::vector<unsigned int> &src,
+                            std::vector<unsigned int> &dst, std::size_t lo,
+                            std::size_t mid, std::size_t hi,
+                            unsigned int num_threads)
+  {
+    const unsigned int *a = src.data() + lo;
+    const unsigned int *b = src.data() + mid;
+    const std::size_t na = mid - lo;
+    const std::size_t nb = hi - mid;
+    const std::size_t n = na + nb;
+    if (num_threads < 2 || n < kParallelCutoff)
+    {
+      MergeInto(a, na, b, nb, dst.data() + lo);
+      return;
+    }
+
+    std::vector<std::thread> workers;
+    std::size_t k_begin = 0;
+    std::size_t i_begin = 0;
+    for (unsigned int t = 1; t <= num_threads; ++t)
+    {
+      const std::size_t k_end = n * t / num_threads;
+      const std::size_t i_end = CoRank(a, na, b, nb, k_end);
+      const std::size_t j_begin = k_begin - i_begin;
+      const std::size_t j_end = k_end - i_end;
+      unsigned int *out = dst.data() + lo + k_begin;
+      if (t == num_threads)
+        MergeInto(a + i_begin, i_end - i_begin, b + j_begin, j_end - j_begin,
+                  out);
+      else
+        workers.emplace_back(MergeInto, a + i_begin, i_end - i_begin,
+                             b + j_begin, j_end - j_begin, out);
+      k_begin = k_end;
+      i_begin = i_end;
+    }
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  // Sorts [lo, hi) into dst. src and dst hold the same keys in [lo, hi) on
+  // entry; the halves are sorted into src and then merged into dst, so the
+  // buffers swap roles on every level instead of copying back.
+  static void SortInto(std::vector<unsigned int> &src,
+                       std::vector<unsigned int> &dst, std::size_t lo,
+                       std::size_t hi, unsigned int num_threads)
+  {
+    if (hi - lo <= kInsertionThreshold)
+    {
+      InsertionsortRange(dst, lo, hi);
+      return;
+    }
+    const std::size_t mid = lo + (hi - lo) / 2;
+    if (num_threads > 1 && hi - lo >= kParallelCutoff)
+    {
+      const unsigned int left_threads = num_threads / 2;
+      std::thread left(SortInto, std::ref(dst), std::ref(src), lo, mid,
+                       left_threads);
+      SortInto(dst, src, mid, hi, num_threads - left_threads);
+      left.join();
+    }
+    else
+    {
+      SortInto(dst, src, lo, mid, 1);
+      SortInto(dst, src, mid, hi, 1);
+    }
+    ParallelMerge(src, dst, lo, mid, hi, num_threads);
+  }
+
+  void ParallelMergesort(std::vector<unsigned int> &array,
+                         unsigned int num_threads)
+  {
+    if (array.size() < 2)
+      return;
+    std::vector<unsigned int> tmp(array);
+    SortInto(tmp, array, 0, array.size(), std::max(num_threads, 1u));
+  }
+
+  void ParallelMergesort(std::vector<unsigned int> &array)
+  {
+    ParallelMergesort(array, std::thread::hardware_concurrency());
+  }
+
+} // namespace mapra
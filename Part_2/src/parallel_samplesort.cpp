@@ -0,0 +1,157 @@
+#include "../include/parallel_samplesort.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/introsort.h"
+#include "../include/radixsort.h"
+
+namespace mapra
+{
+
+  // Arrays below this size are sorted by RadixSort on the calling thread.
+  static const std::size_t kParallelCutoff = std::size_t{1} << 15;
+  // Every thread gets at least this many keys.
+  static const std::size_t kMinKeysPerThread = std::size_t{1} << 12;
+  // Bucket indices are stored as 16 bit, which bounds the thread count.
+  static const unsigned int kMaxThreads = 1024;
+  // More buckets than threads even out the sorting phase.
+  static const std::size_t kBucketsPerThread = 4;
+  // Sample keys per bucket.
+  static const std::size_t kOversampling = 32;
+
+  // Runs work(0), ..., work(num_threads - 1) concurrently, work(0) on the
+  // calling thread.
+  static void RunOnThreads(unsigned int num_threads,
+                           const std::function<void(unsigned int)> &work)
+  {
+    std::vector<std::thread> workers;
+    for (unsigned int t = 1; t < num_threads; ++t)
+      workers.emplace_back(work, t);
+    work(0);
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  // Index of the first of the count >= 1 splitters that is >= key, or
+  // count if there is none. The loop length only depends on count, and
+  // the comparison selects the next step with a conditional move.
+  static std::size_t LowerBound(const unsigned int *splitters,
+                                std::size_t count, unsigned int key)
+  {
+    const unsigned int *base = splitters;
+    while (count > 1)
+    {
+      const std::size_t half = count / 2;
+      base = base[half] < key ? base + half : base;
+      count -= half;
+    }
+    return (base - splitters) + (*base < key);
+  }
+
+  void ParallelSamplesort(std::vector<unsigned int> &array,
+                          unsigned int num_threads)
+  {
+    const std::size_t n = array.size();
+    const unsigned int threads = static_cast<unsigned int>(
+        std::min<std::size_t>({num_threads, kMaxThreads,
+                               n / kMinKeysPerThread}));
+    if (threads < 2 || n < kParallelCutoff)
+    {
+      RadixSort(array);
+      return;
+    }
+
+    // Splitters s[0, b - 1) from a sorted sample of b * kOversampling keys.
+    const std::size_t buckets = kBucketsPerThread * threads;
+    std::mt19937 generator(static_cast<unsigned int>(n));
+    std::vector<unsigned int> sample(buckets * kOversampling);
+    for (auto &key : sample)
+      key = array[generator() % n];
+    Introsort(sample);
+    std::vector<unsigned int> splitters(buckets - 1);
+    for (std::size_t i = 0; i + 1 < buckets; ++i)
+      splitters[i] = sample[(i + 1) * kOversampling];
+
+    // Key x goes to class 2j for s[j - 1] < x < s[j] and to the equality
+    // class 2j + 1 for x == s[j].
+    const std::size_t classes = 2 * buckets - 1;
+    std::vector<std::uint16_t> oracle(n);
+    std::vector<std::vector<std::size_t>> offsets(
+        threads, std::vector<std::size_t>(classes, 0));
+    auto block_begin = [&](unsigned int t) { return n * t / threads; };
+
+    RunOnThreads(threads,
+                 [&](unsigned int t)
+                 {
+                   std::vector<std::size_t> &count = offsets[t];
+                   for (std::size_t i = block_begin(t); i < block_begin(t + 1);
+                        ++i)
+                   {
+                     const unsigned int key = array[i];
+                     const std::size_t j =
+                         LowerBound(splitters.data(), buckets - 1, key);
+                     const std::size_t c =
+                         2 * j + (j + 1 < buckets && splitters[j] == key);
+                     oracle[i] = static_cast<std::uint16_t>(c);
+                     ++count[c];
+                   }
+                 });
+
+    // Class c starts at class_begin[c]; inside it, the keys of thread t
+    // follow those of threads 0, ..., t - 1.
+    std::vector<std::size_t> class_begin(classes + 1);
+    std::size_t running = 0;
+    for (std::size_t c = 0; c < classes; ++c)
+    {
+      class_begin[c] = running;
+      for (unsigned int t = 0; t < threads; ++t)
+      {
+        const std::size_t count = offsets[t][c];
+        offsets[t][c] = running;
+        running += count;
+      }
+    }
+    class_begin[classes] = n;
+
+    std::vector<unsigned int> scratch(n);
+    RunOnThreads(threads,
+                 [&](unsigned int t)
+                 {
+                   std::vector<std::size_t> &offset = offsets[t];
+                   for (std::size_t i = block_begin(t); i < block_begin(t + 1);
+                        ++i)
+                     scratch[offset[oracle[i]]++] = array[i];
+                 });
+    array.swap(scratch);
+
+    // The threads take the buckets one by one; equality classes are done.
+    // RadixSort skips the byte passes that are constant within a bucket.
+    std::atomic<std::size_t> next_bucket(0);
+    RunOnThreads(threads,
+                 [&](unsigned int)
+                 {
+                   std::vector<unsigned int> bucket;
+                   std::size_t j;
+                   while ((j = next_bucket++) < buckets)
+                   {
+                     auto begin = array.begin() + class_begin[2 * j];
+                     auto end = array.begin() + class_begin[2 * j + 1];
+                     bucket.assign(begin, end);
+                     RadixSort(bucket);
+                     std::copy(bucket.begin(), bucket.end(), begin);
+                   }
+                 });
+  }
+
+  void ParallelSamplesort(std::vector<unsigned int> &array)
+  {
+    ParallelSamplesort(array, std::thread::hardware_concurrency());
+  }
+
+} // namespace mapra
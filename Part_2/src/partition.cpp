@@ -0,0 +1,49 @@
+#include "../include/partition.h"
+
+#include <utility> // for std::swap
+
+#include "../include/sort_stats.h"
+
+namespace mapra
+{
+
+  std::size_t LomutoPartition(std::vector<unsigned int> &a, std::size_t lo,
+                              std::size_t hi)
+  {
+    const unsigned int pivot = a[hi];
+    std::size_t i = lo;
+    for (std::size_t j = lo; j < hi; ++j)
+    {
+      if (CountCompare(a[j] < pivot))
+      {
+        std::swap(a[i], a[j]);
+        CountSwap();
+        ++i;
+      }
+    }
+    std::swap(a[i], a[hi]);
+    CountSwap();
+    return i;
+  }
+
+  std::size_t BranchlessLomutoPartition(std::vector<unsigned int> &a,
+                                        std::size_t lo, std::size_t hi)
+  {
+    const unsigned int pivot = a[hi];
+    unsigned int *data = a.data();
+    std::size_t i = lo;
+    for (std::size_t j = lo; j < hi; ++j)
+    {
+      // a[lo, i) < pivot <= a[i, j); the swap is harmless if a[j] >= pivot.
+      const unsigned int x = data[j];
+      data[j] = data[i];
+      data[i] = x;
+      i += CountCompare(x < pivot);
+      CountSwap();
+    }
+    std::swap(data[i], data[hi]);
+    CountSwap();
+    return i;
+  }
+
+} // namespace mapra
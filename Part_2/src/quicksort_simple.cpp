@@ -1,37 +1,41 @@
 #include "../include/quicksort_simple.h"
 
-#include <utility>
+#include "../include/partition.h"
+#include "../include/sort_small.h"
+#include "../include/sort_stats.h"
 
 namespace mapra
 {
 
   static void QS_Simple(std::vector<unsigned int> &a, std::size_t lo,
-                        std::size_t hi)
+                        std::size_t hi, PartitionFunction partition)
   {
+    DepthCounter depth;
     if (lo < hi)
     {
-      // Partition around last element
-      unsigned int pivot = a[hi];
-      std::size_t i = lo;
-      for (std::size_t j = lo; j < hi; ++j)
+      if (hi - lo < kSortSmallMax) // at most kSortSmallMax elements
       {
-        if (a[j] < pivot)
-        {
-          std::swap(a[i], a[j]);
-          ++i;
-        }
+        SortSmall(a.data() + lo, hi - lo + 1);
+        return;
       }
-      std::swap(a[i], a[hi]);
+      // Partition around last element
+      std::size_t i = partition(a, lo, hi);
       if (i > 0)
-        QS_Simple(a, lo, i - 1);
-      QS_Simple(a, i + 1, hi);
+        QS_Simple(a, lo, i - 1, partition);
+      QS_Simple(a, i + 1, hi, partition);
     }
   }
 
   void QuicksortSimple(std::vector<unsigned int> &array)
   {
     if (!array.empty())
-      QS_Simple(array, 0, array.size() - 1);
+      QS_Simple(array, 0, array.size() - 1, LomutoPartition);
+  }
+
+  void QuicksortSimpleBranchless(std::vector<unsigned int> &array)
+  {
+    if (!array.empty())
+      QS_Simple(array, 0, array.size() - 1, BranchlessLomutoPartition);
   }
 
 } // namespace mapra
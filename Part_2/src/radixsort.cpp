@@ -0,0 +1,59 @@
+#include "../include/radixsort.h"
+
+#include <cstddef>
+#include <utility> // for std::swap
+#include <vector>
+
+namespace mapra
+{
+
+  static const unsigned int kDigitBits = 8;
+  static const std::size_t kNumBuckets = std::size_t{1} << kDigitBits;
+  static const unsigned int kNumPasses = 32 / kDigitBits;
+
+  void RadixSort(std::vector<unsigned int> &array)
+  {
+    const std::size_t n = array.size();
+    if (n < 2)
+      return;
+
+    // Histograms of all digits in a single read pass over the keys.
+    std::vector<std::size_t> counts(kNumPasses * kNumBuckets, 0);
+    for (unsigned int key : array)
+    {
+      for (unsigned int pass = 0; pass < kNumPasses; ++pass)
+        ++counts[pass * kNumBuckets +
+                 ((key >> (pass * kDigitBits)) & (kNumBuckets - 1))];
+    }
+
+    std::vector<unsigned int> scratch(n);
+    std::vector<unsigned int> *from = &array;
+    std::vector<unsigned int> *to = &scratch;
+    for (unsigned int pass = 0; pass < kNumPasses; ++pass)
+    {
+      std::size_t *count = &counts[pass * kNumBuckets];
+      const unsigned int shift = pass * kDigitBits;
+
+      // All keys share this digit: the pass would not move anything.
+      if (count[((*from)[0] >> shift) & (kNumBuckets - 1)] == n)
+        continue;
+
+      // Turn the counts into bucket start offsets.
+      std::size_t offset = 0;
+      for (std::size_t bucket = 0; bucket < kNumBuckets; ++bucket)
+      {
+        const std::size_t size = count[bucket];
+        count[bucket] = offset;
+        offset += size;
+      }
+
+      for (unsigned int key : *from)
+        (*to)[count[(key >> shift) & (kNumBuckets - 1)]++] = key;
+      std::swap(from, to);
+    }
+
+    if (from != &array)
+      array.swap(scratch);
+  }
+
+} // namespace mapra
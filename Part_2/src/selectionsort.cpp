@@ -2,6 +2,8 @@
 
 #include <utility> // for std::swap
 
+#include "../include/sort_stats.h"
+
 namespace mapra
 {
 
@@ -13,7 +15,7 @@ namespace mapra
       std::size_t min_idx = i;
       for (std::size_t j = i + 1; j < n; ++j)
       {
-        if (array[j] < array[min_idx])
+        if (CountCompare(array[j] < array[min_idx]))
         {
           min_idx = j;
         }
@@ -21,6 +23,7 @@ namespace mapra
       if (min_idx != i)
       {
         std::swap(array[i], array[min_idx]);
+        CountSwap();
       }
     }
   }
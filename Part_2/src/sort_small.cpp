@@ -0,0 +1,322 @@
+#include "../include/sort_small.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "../include/sort_stats.h"
+
+namespace mapra
+{
+
+  // Comparator: a[i] = min, a[j] = max. Compiles to cmov/min/max, no jump.
+  // With -DMAPRA_SORT_STATS every comparator counts one comparison and,
+  // if it exchanges the keys, one swap, like the partition loops do.
+  static inline void CompareSwap(unsigned int *a, std::size_t i,
+                                 std::size_t j)
+  {
+    const unsigned int x = a[i];
+    const unsigned int y = a[j];
+    const bool less = CountCompare(y < x);
+    if (kSortStatsEnabled && less)
+      CountSwap();
+    a[i] = less ? y : x;
+    a[j] = less ? x : y;
+  }
+
+  // The networks below are listed layer by layer (comparators on one line
+  // touch disjoint wires). They were checked with the 0-1 principle: a
+  // network sorts every input iff it sorts all 2^n sequences of 0s and 1s.
+
+  // 1 comparator, depth 1.
+  static void Sort2(unsigned int *a)
+  {
+    CompareSwap(a, 0, 1);
+  }
+
+  // 3 comparators, depth 3.
+  static void Sort3(unsigned int *a)
+  {
+    CompareSwap(a, 0, 2);
+    CompareSwap(a, 0, 1);
+    CompareSwap(a, 1, 2);
+  }
+
+  // 5 comparators, depth 3.
+  static void Sort4(unsigned int *a)
+  {
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 3);
+    CompareSwap(a, 1, 2);
+  }
+
+  // 9 comparators, depth 5.
+  static void Sort5(unsigned int *a)
+  {
+    CompareSwap(a, 0, 4); CompareSwap(a, 1, 3);
+    CompareSwap(a, 0, 2);
+    CompareSwap(a, 2, 4); CompareSwap(a, 0, 1);
+    CompareSwap(a, 2, 3); CompareSwap(a, 1, 4);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 4);
+  }
+
+  // 12 comparators, depth 6.
+  static void Sort6(unsigned int *a)
+  {
+    CompareSwap(a, 0, 4); CompareSwap(a, 1, 5);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 5); CompareSwap(a, 0, 1);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 1, 4);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 4);
+  }
+
+  // 16 comparators, depth 6.
+  static void Sort7(unsigned int *a)
+  {
+    CompareSwap(a, 0, 4); CompareSwap(a, 1, 5); CompareSwap(a, 2, 6);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 6);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 5); CompareSwap(a, 0, 1);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 1, 4); CompareSwap(a, 3, 6);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 4); CompareSwap(a, 5, 6);
+  }
+
+  // 19 comparators, depth 6.
+  static void Sort8(unsigned int *a)
+  {
+    CompareSwap(a, 0, 4); CompareSwap(a, 1, 5); CompareSwap(a, 2, 6);
+    CompareSwap(a, 3, 7);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 5); CompareSwap(a, 0, 1);
+    CompareSwap(a, 6, 7);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 1, 4); CompareSwap(a, 3, 6);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 4); CompareSwap(a, 5, 6);
+  }
+
+  // 25 comparators, depth 8.
+  static void Sort9(unsigned int *a)
+  {
+    CompareSwap(a, 0, 8); CompareSwap(a, 2, 7); CompareSwap(a, 3, 5);
+    CompareSwap(a, 4, 6);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 4); CompareSwap(a, 5, 8);
+    CompareSwap(a, 0, 3); CompareSwap(a, 2, 4); CompareSwap(a, 5, 7);
+    CompareSwap(a, 0, 1); CompareSwap(a, 3, 6); CompareSwap(a, 4, 8);
+    CompareSwap(a, 1, 5); CompareSwap(a, 2, 3); CompareSwap(a, 6, 7);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 5); CompareSwap(a, 4, 6);
+    CompareSwap(a, 7, 8);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5); CompareSwap(a, 6, 7);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6);
+  }
+
+  // 29 comparators, depth 8.
+  static void Sort10(unsigned int *a)
+  {
+    CompareSwap(a, 0, 8); CompareSwap(a, 1, 9); CompareSwap(a, 2, 7);
+    CompareSwap(a, 3, 5); CompareSwap(a, 4, 6);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 4); CompareSwap(a, 5, 8);
+    CompareSwap(a, 7, 9);
+    CompareSwap(a, 0, 3); CompareSwap(a, 2, 4); CompareSwap(a, 5, 7);
+    CompareSwap(a, 6, 9);
+    CompareSwap(a, 0, 1); CompareSwap(a, 3, 6); CompareSwap(a, 8, 9);
+    CompareSwap(a, 1, 5); CompareSwap(a, 2, 3); CompareSwap(a, 4, 8);
+    CompareSwap(a, 6, 7);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 5); CompareSwap(a, 4, 6);
+    CompareSwap(a, 7, 8);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5); CompareSwap(a, 6, 7);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6);
+  }
+
+  // 35 comparators, depth 9.
+  static void Sort11(unsigned int *a)
+  {
+    CompareSwap(a, 0, 8); CompareSwap(a, 1, 7); CompareSwap(a, 2, 6);
+    CompareSwap(a, 4, 10); CompareSwap(a, 5, 9);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 5); CompareSwap(a, 3, 4);
+    CompareSwap(a, 6, 9); CompareSwap(a, 7, 8);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 6); CompareSwap(a, 5, 10);
+    CompareSwap(a, 0, 3); CompareSwap(a, 1, 2); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 9, 10);
+    CompareSwap(a, 1, 4); CompareSwap(a, 3, 5); CompareSwap(a, 6, 8);
+    CompareSwap(a, 7, 10);
+    CompareSwap(a, 1, 3); CompareSwap(a, 2, 5); CompareSwap(a, 6, 9);
+    CompareSwap(a, 8, 10);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5); CompareSwap(a, 6, 7);
+    CompareSwap(a, 8, 9);
+    CompareSwap(a, 4, 6); CompareSwap(a, 5, 7);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+  }
+
+  // 39 comparators, depth 9.
+  static void Sort12(unsigned int *a)
+  {
+    CompareSwap(a, 0, 8); CompareSwap(a, 1, 7); CompareSwap(a, 2, 6);
+    CompareSwap(a, 3, 11); CompareSwap(a, 4, 10); CompareSwap(a, 5, 9);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 5); CompareSwap(a, 3, 4);
+    CompareSwap(a, 6, 9); CompareSwap(a, 7, 8); CompareSwap(a, 10, 11);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 6); CompareSwap(a, 5, 10);
+    CompareSwap(a, 9, 11);
+    CompareSwap(a, 0, 3); CompareSwap(a, 1, 2); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 8, 11); CompareSwap(a, 9, 10);
+    CompareSwap(a, 1, 4); CompareSwap(a, 3, 5); CompareSwap(a, 6, 8);
+    CompareSwap(a, 7, 10);
+    CompareSwap(a, 1, 3); CompareSwap(a, 2, 5); CompareSwap(a, 6, 9);
+    CompareSwap(a, 8, 10);
+    CompareSwap(a, 2, 3); CompareSwap(a, 4, 5); CompareSwap(a, 6, 7);
+    CompareSwap(a, 8, 9);
+    CompareSwap(a, 4, 6); CompareSwap(a, 5, 7);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+  }
+
+  // 46 comparators, depth 10.
+  static void Sort13(unsigned int *a)
+  {
+    CompareSwap(a, 1, 12); CompareSwap(a, 4, 8); CompareSwap(a, 5, 6);
+    CompareSwap(a, 7, 11); CompareSwap(a, 9, 10);
+    CompareSwap(a, 0, 5); CompareSwap(a, 1, 7); CompareSwap(a, 2, 9);
+    CompareSwap(a, 3, 4); CompareSwap(a, 11, 12); CompareSwap(a, 6, 8);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 7, 9); CompareSwap(a, 10, 11);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 10);
+    CompareSwap(a, 5, 11); CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 12); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 8, 10); CompareSwap(a, 9, 11);
+    CompareSwap(a, 1, 4); CompareSwap(a, 2, 6); CompareSwap(a, 5, 8);
+    CompareSwap(a, 7, 10); CompareSwap(a, 9, 12);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 6); CompareSwap(a, 7, 9);
+    CompareSwap(a, 10, 12);
+    CompareSwap(a, 3, 5); CompareSwap(a, 6, 8); CompareSwap(a, 9, 10);
+    CompareSwap(a, 11, 12);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+    CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+  }
+
+  // 51 comparators, depth 10.
+  static void Sort14(unsigned int *a)
+  {
+    CompareSwap(a, 0, 13); CompareSwap(a, 1, 12); CompareSwap(a, 4, 8);
+    CompareSwap(a, 5, 6); CompareSwap(a, 7, 11); CompareSwap(a, 9, 10);
+    CompareSwap(a, 0, 5); CompareSwap(a, 1, 7); CompareSwap(a, 2, 9);
+    CompareSwap(a, 3, 4); CompareSwap(a, 6, 13); CompareSwap(a, 11, 12);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 6, 8); CompareSwap(a, 7, 9); CompareSwap(a, 10, 11);
+    CompareSwap(a, 12, 13);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 10);
+    CompareSwap(a, 5, 11); CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 12); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 8, 10); CompareSwap(a, 9, 11);
+    CompareSwap(a, 1, 4); CompareSwap(a, 2, 6); CompareSwap(a, 5, 8);
+    CompareSwap(a, 7, 10); CompareSwap(a, 9, 13);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 6); CompareSwap(a, 9, 12);
+    CompareSwap(a, 11, 13);
+    CompareSwap(a, 3, 5); CompareSwap(a, 6, 8); CompareSwap(a, 7, 9);
+    CompareSwap(a, 10, 12);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+    CompareSwap(a, 9, 10); CompareSwap(a, 11, 12);
+    CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+  }
+
+  // 56 comparators, depth 10.
+  static void Sort15(unsigned int *a)
+  {
+    CompareSwap(a, 0, 13); CompareSwap(a, 1, 12); CompareSwap(a, 3, 14);
+    CompareSwap(a, 4, 8); CompareSwap(a, 5, 6); CompareSwap(a, 7, 11);
+    CompareSwap(a, 9, 10);
+    CompareSwap(a, 0, 5); CompareSwap(a, 1, 7); CompareSwap(a, 2, 9);
+    CompareSwap(a, 3, 4); CompareSwap(a, 6, 13); CompareSwap(a, 8, 14);
+    CompareSwap(a, 11, 12);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 6, 8); CompareSwap(a, 7, 9); CompareSwap(a, 10, 11);
+    CompareSwap(a, 12, 13);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 10);
+    CompareSwap(a, 5, 11); CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+    CompareSwap(a, 12, 14);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 12); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 8, 10); CompareSwap(a, 9, 11);
+    CompareSwap(a, 13, 14);
+    CompareSwap(a, 1, 4); CompareSwap(a, 2, 6); CompareSwap(a, 5, 8);
+    CompareSwap(a, 7, 10); CompareSwap(a, 9, 13); CompareSwap(a, 11, 14);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 6); CompareSwap(a, 9, 12);
+    CompareSwap(a, 11, 13);
+    CompareSwap(a, 3, 5); CompareSwap(a, 6, 8); CompareSwap(a, 7, 9);
+    CompareSwap(a, 10, 12);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+    CompareSwap(a, 9, 10); CompareSwap(a, 11, 12);
+    CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+  }
+
+  // 60 comparators, depth 10.
+  static void Sort16(unsigned int *a)
+  {
+    CompareSwap(a, 0, 13); CompareSwap(a, 1, 12); CompareSwap(a, 2, 15);
+    CompareSwap(a, 3, 14); CompareSwap(a, 4, 8); CompareSwap(a, 5, 6);
+    CompareSwap(a, 7, 11); CompareSwap(a, 9, 10);
+    CompareSwap(a, 0, 5); CompareSwap(a, 1, 7); CompareSwap(a, 2, 9);
+    CompareSwap(a, 3, 4); CompareSwap(a, 6, 13); CompareSwap(a, 8, 14);
+    CompareSwap(a, 10, 15); CompareSwap(a, 11, 12);
+    CompareSwap(a, 0, 1); CompareSwap(a, 2, 3); CompareSwap(a, 4, 5);
+    CompareSwap(a, 6, 8); CompareSwap(a, 7, 9); CompareSwap(a, 10, 11);
+    CompareSwap(a, 12, 13); CompareSwap(a, 14, 15);
+    CompareSwap(a, 0, 2); CompareSwap(a, 1, 3); CompareSwap(a, 4, 10);
+    CompareSwap(a, 5, 11); CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+    CompareSwap(a, 12, 14); CompareSwap(a, 13, 15);
+    CompareSwap(a, 1, 2); CompareSwap(a, 3, 12); CompareSwap(a, 4, 6);
+    CompareSwap(a, 5, 7); CompareSwap(a, 8, 10); CompareSwap(a, 9, 11);
+    CompareSwap(a, 13, 14);
+    CompareSwap(a, 1, 4); CompareSwap(a, 2, 6); CompareSwap(a, 5, 8);
+    CompareSwap(a, 7, 10); CompareSwap(a, 9, 13); CompareSwap(a, 11, 14);
+    CompareSwap(a, 2, 4); CompareSwap(a, 3, 6); CompareSwap(a, 9, 12);
+    CompareSwap(a, 11, 13);
+    CompareSwap(a, 3, 5); CompareSwap(a, 6, 8); CompareSwap(a, 7, 9);
+    CompareSwap(a, 10, 12);
+    CompareSwap(a, 3, 4); CompareSwap(a, 5, 6); CompareSwap(a, 7, 8);
+    CompareSwap(a, 9, 10); CompareSwap(a, 11, 12);
+    CompareSwap(a, 6, 7); CompareSwap(a, 8, 9);
+  }
+
+  void SortSmall(unsigned int *data, std::size_t n)
+  {
+    switch (n)
+    {
+    case 0:
+    case 1:
+      return;
+    case 2:
+      return Sort2(data);
+    case 3:
+      return Sort3(data);
+    case 4:
+      return Sort4(data);
+    case 5:
+      return Sort5(data);
+    case 6:
+      return Sort6(data);
+    case 7:
+      return Sort7(data);
+    case 8:
+      return Sort8(data);
+    case 9:
+      return Sort9(data);
+    case 10:
+      return Sort10(data);
+    case 11:
+      return Sort11(data);
+    case 12:
+      return Sort12(data);
+    case 13:
+      return Sort13(data);
+    case 14:
+      return Sort14(data);
+    case 15:
+      return Sort15(data);
+    case 16:
+      return Sort16(data);
+    default:
+      throw std::length_error("SortSmall: " + std::to_string(n) +
+                              " elements, at most " +
+                              std::to_string(kSortSmallMax) + " supported");
+    }
+  }
+
+} // namespace mapra
@@ -0,0 +1,265 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Mapra libraries
+#include "../include/unit.h"
+
+// Algorithms
+#include "../include/adaptive_mergesort.h"
+#include "../include/bubblesort.h"
+#include "../include/heapsort.h"
+#include "../include/insertionsort.h"
+#include "../include/introsort.h"
+#include "../include/mergesort.h"
+#include "../include/parallel_mergesort.h"
+#include "../include/parallel_samplesort.h"
+#include "../include/quicksort_median3.h"
+#include "../include/quicksort_simple.h"
+#include "../include/radixsort.h"
+#include "../include/selectionsort.h"
+#include "../include/sort_stats.h"
+
+// Runs every sorter over several input distributions and sizes
+// 10^min_exp .. 10^max_exp and prints the time per element as CSV or JSON.
+//
+// Usage: ./benchmark [--format=csv|json] [--min-exp=2] [--max-exp=6]
+//                    [--quadratic-limit=10000] [--seed=2022]
+// Sorters whose worst case is O(n^2) are skipped above --quadratic-limit.
+// Built with -DMAPRA_SORT_STATS, the comparisons and swaps of one run are
+// reported as well (empty/null for the sorters without counters).
+
+struct Sorter
+{
+  std::string name;
+  std::function<void(std::vector<unsigned int> &)> fn;
+  bool quadratic; // O(n^2) worst case
+  bool counted;   // instrumented with the sort_stats.h hooks
+};
+
+struct Distribution
+{
+  std::string name;
+  std::function<std::vector<unsigned int>(std::size_t, std::mt19937 &)> make;
+};
+
+// mapra::GetExample reports every generated example on std::cout, which
+// would end up in the CSV output.
+static std::vector<unsigned int> QuietExample(unsigned int id, std::size_t n)
+{
+  std::ostringstream sink;
+  std::streambuf *original = std::cout.rdbuf(sink.rdbuf());
+  std::vector<unsigned int> array = mapra::GetExample(id, n);
+  std::cout.rdbuf(original);
+  return array;
+}
+
+static std::vector<Distribution> Distributions()
+{
+  using Array = std::vector<unsigned int>;
+  return {
+      {"random",
+       [](std::size_t n, std::mt19937 &g)
+       {
+         Array a(n);
+         for (auto &x : a)
+           x = g();
+         return a;
+       }},
+      {"sorted",
+       [](std::size_t n, std::mt19937 &)
+       {
+         Array a(n);
+         for (std::size_t i = 0; i < n; ++i)
+           a[i] = i;
+         return a;
+       }},
+      {"reverse",
+       [](std::size_t n, std::mt19937 &)
+       {
+         Array a(n);
+         for (std::size_t i = 0; i < n; ++i)
+           a[i] = n - i;
+         return a;
+       }},
+      {"organ-pipe",
+       [](std::size_t n, std::mt19937 &)
+       {
+         Array a(n);
+         for (std::size_t i = 0; i < n; ++i)
+           a[i] = i < n / 2 ? i : n - i;
+         return a;
+       }},
+      {"few-unique",
+       [](std::size_t n, std::mt19937 &g)
+       {
+         Array a(n);
+         for (auto &x : a)
+           x = g() % 16;
+         return a;
+       }},
+      {"sawtooth",
+       [](std::size_t n, std::mt19937 &)
+       {
+         Array a(n);
+         for (std::size_t i = 0; i < n; ++i)
+           a[i] = i % 1000;
+         return a;
+       }},
+      {"GetExample1", [](std::size_t n, std::mt19937 &)
+       { return QuietExample(1, n); }},
+      {"GetExample2", [](std::size_t n, std::mt19937 &)
+       { return QuietExample(2, n); }},
+      {"GetExample3", [](std::size_t n, std::mt19937 &)
+       { return QuietExample(3, n); }},
+  };
+}
+
+// Average time per element. Fast runs are repeated (always on a fresh
+// copy of the input) until they add up to about 20 ms.
+static double NanosecondsPerElement(const Sorter &sorter,
+                                    const std::vector<unsigned int> &input)
+{
+  const std::chrono::duration<double, std::nano> min_total(2e7);
+  std::chrono::duration<double, std::nano> total(0);
+  std::size_t repetitions = 0;
+  while (total < min_total)
+  {
+    std::vector<unsigned int> array = input;
+    const auto start = std::chrono::steady_clock::now();
+    sorter.fn(array);
+    total += std::chrono::steady_clock::now() - start;
+    ++repetitions;
+  }
+  return total.count() / (static_cast<double>(input.size()) * repetitions);
+}
+
+// Operation counts of a single run of `sorter` on `input`.
+static mapra::SortStats CountOperations(const Sorter &sorter,
+                                        const std::vector<unsigned int> &input)
+{
+  std::vector<unsigned int> array = input;
+  mapra::ResetSortStats();
+  sorter.fn(array);
+  return mapra::CurrentSortStats();
+}
+
+int main(int argc, char *argv[])
+{
+  std::string format = "csv";
+  int min_exp = 2;
+  int max_exp = 6;
+  std::size_t quadratic_limit = 10000;
+  unsigned int seed = 2022;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const std::size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value =
+        eq == std::string::npos ? "" : arg.substr(eq + 1);
+    if (key == "--format")
+      format = value;
+    else if (key == "--min-exp")
+      min_exp = std::stoi(value);
+    else if (key == "--max-exp")
+      max_exp = std::stoi(value);
+    else if (key == "--quadratic-limit")
+      quadratic_limit = std::stoull(value);
+    else if (key == "--seed")
+      seed = std::stoul(value);
+    else
+    {
+      std::cerr << "Unknown argument " << arg << "\n";
+      return 1;
+    }
+  }
+
+  std::vector<Sorter> algorithms = {
+      {"BubbleSort", mapra::Bubblesort, true, true},
+      {"SelectionSort", mapra::Selectionsort, true, true},
+      {"InsertionSort", mapra::Insertionsort, true, true},
+      {"HeapSort", mapra::Heapsort, false, true},
+      {"BottomUpHeapsort", mapra::BottomUpHeapsort, false, false},
+      {"4-aryHeapsort", mapra::DaryHeapsort<4>, false, false},
+      {"8-aryHeapsort", mapra::DaryHeapsort<8>, false, false},
+      {"QuicksortSimple", mapra::QuicksortSimple, true, true},
+      {"QuicksortMedian3", mapra::QuicksortMedian3, true, true},
+      {"QuicksortSimpleBranchless", mapra::QuicksortSimpleBranchless, true, true},
+      {"QuicksortMedian3Branchless", mapra::QuicksortMedian3Branchless, true, true},
+      {"Mergesort", mapra::Mergesort, false, true},
+      {"Introsort", mapra::Introsort, false, false},
+      {"RadixSort", mapra::RadixSort, false, false},
+      {"ParallelMergesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelMergesort(a); },
+       false, false},
+      {"ParallelSamplesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelSamplesort(a); },
+       false, false},
+      {"AdaptiveMergesort", mapra::AdaptiveMergesort, false, false},
+  };
+
+  const bool json = format == "json";
+  if (json)
+    std::cout << "[\n";
+  else
+    std::cout << "algorithm,distribution,n,ns_per_element,comparisons,"
+                 "swaps\n";
+
+  bool first = true;
+  for (const auto &distribution : Distributions())
+  {
+    std::size_t n = 1;
+    for (int e = 0; e < min_exp; ++e)
+      n *= 10;
+    for (int e = min_exp; e <= max_exp; ++e, n *= 10)
+    {
+      std::mt19937 generator(seed);
+      const std::vector<unsigned int> input =
+          distribution.make(n, generator);
+      for (const auto &sorter : algorithms)
+      {
+        if (sorter.quadratic && n > quadratic_limit)
+          continue;
+        const double ns = NanosecondsPerElement(sorter, input);
+        const bool counted = mapra::kSortStatsEnabled && sorter.counted;
+        mapra::SortStats stats;
+        if (counted)
+          stats = CountOperations(sorter, input);
+        if (json)
+        {
+          std::cout << (first ? "" : ",\n") << "  {\"algorithm\": \""
+                    << sorter.name << "\", \"distribution\": \""
+                    << distribution.name << "\", \"n\": " << n
+                    << ", \"ns_per_element\": " << ns << ", \"comparisons\": ";
+          if (counted)
+            std::cout << stats.comparisons << ", \"swaps\": " << stats.swaps
+                      << "}";
+          else
+            std::cout << "null, \"swaps\": null}";
+        }
+        else
+        {
+          std::cout << sorter.name << ',' << distribution.name << ',' << n
+                    << ',' << ns << ',';
+          if (counted)
+            std::cout << stats.comparisons << ',' << stats.swaps;
+          else
+            std::cout << ',';
+          std::cout << "\n";
+        }
+        std::cout.flush();
+        first = false;
+      }
+    }
+  }
+  if (json)
+    std::cout << "\n]\n";
+
+  return 0;
+}
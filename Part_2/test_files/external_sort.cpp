@@ -0,0 +1,38 @@
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "../include/external_sort.h"
+
+// Sorts a binary file of 32-bit unsigned keys that may not fit into memory.
+// Usage: ./external_sort input output [memory_mb = 1024] [temp_dir]
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " input output [memory_mb = 1024] [temp_dir]\n";
+    return 1;
+  }
+  const std::size_t memory_bytes =
+      argc > 3 ? std::stoull(argv[3]) << 20 : mapra::kExternalSortMemory;
+  const std::string temp_dir = argc > 4 ? argv[4] : "";
+
+  try
+  {
+    const auto start = std::chrono::steady_clock::now();
+    mapra::ExternalSort(argv[1], argv[2], memory_bytes, temp_dir);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Sorted " << argv[1] << " in " << elapsed.count()
+              << " s\n";
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << e.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
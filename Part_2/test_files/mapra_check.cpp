@@ -8,13 +8,19 @@
 #include "../include/unit.h"
 
 // Algorithms
+#include "../include/adaptive_mergesort.h"
 #include "../include/bubblesort.h"
 #include "../include/heapsort.h"
 #include "../include/insertionsort.h"
+#include "../include/introsort.h"
 #include "../include/mergesort.h"
+#include "../include/parallel_mergesort.h"
+#include "../include/parallel_samplesort.h"
 #include "../include/quicksort_median3.h"
 #include "../include/quicksort_simple.h"
+#include "../include/radixsort.h"
 #include "../include/selectionsort.h"
+#include "../include/sort_stats.h"
 
 struct Sorter
 {
@@ -29,9 +35,21 @@ int main()
       {"SelectionSort", mapra::Selectionsort},
       {"InsertionSort", mapra::Insertionsort},
       {"HeapSort", mapra::Heapsort},
+      {"BottomUpHeapsort", mapra::BottomUpHeapsort},
+      {"4-aryHeapsort", mapra::DaryHeapsort<4>},
+      {"8-aryHeapsort", mapra::DaryHeapsort<8>},
       {"QuicksortSimple", mapra::QuicksortSimple},
       {"QuicksortMedian3", mapra::QuicksortMedian3},
+      {"QuicksortSimpleBranchless", mapra::QuicksortSimpleBranchless},
+      {"QuicksortMedian3Branchless", mapra::QuicksortMedian3Branchless},
       {"Mergesort", mapra::Mergesort},
+      {"Introsort", mapra::Introsort},
+      {"RadixSort", mapra::RadixSort},
+      {"ParallelMergesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelMergesort(a); }},
+      {"ParallelSamplesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelSamplesort(a); }},
+      {"AdaptiveMergesort", mapra::AdaptiveMergesort},
   };
   mapra::MapraTest test("AllSorters");
 
@@ -40,8 +58,12 @@ int main()
     for (unsigned int id = 0; id < mapra::kNumExamples; ++id)
     {
       auto arr = mapra::GetExample(id);
+      mapra::ResetSortStats();
       sorter.fn(arr);
-      test.Assert(sorter.name + " example " + std::to_string(id),
+      std::string name = sorter.name + " example " + std::to_string(id);
+      if (mapra::kSortStatsEnabled)
+        name += " (" + mapra::FormatSortStats() + ")";
+      test.Assert(name,
                   mapra::CheckSolution(arr));
     }
   }
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/mergesort.h"
+#include "../include/parallel_mergesort.h"
+#include "../include/parallel_samplesort.h"
+#include "../include/quicksort_median3.h"
+
+// Thread scaling of the parallel sorters against the sequential Mergesort
+// and QuicksortMedian3 on uniformly random keys. Prints CSV.
+// Usage: ./scaling_benchmark [n = 10000000] [max_threads = #cores]
+
+struct ParallelSorter
+{
+  std::string name;
+  std::function<void(std::vector<unsigned int> &, unsigned int)> fn;
+};
+
+using SortFn = std::function<void(std::vector<unsigned int> &)>;
+
+static double TimeSort(const std::vector<unsigned int> &input,
+                       const SortFn &fn)
+{
+  std::vector<unsigned int> array = input;
+  const auto start = std::chrono::steady_clock::now();
+  fn(array);
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::stoull(argv[1]) : 10000000;
+  const unsigned int hardware_threads = std::thread::hardware_concurrency();
+  const unsigned int max_threads =
+      argc > 2 ? std::stoul(argv[2])
+               : (hardware_threads ? hardware_threads : 1);
+
+  std::vector<unsigned int> input(n);
+  std::mt19937 generator(2022);
+  for (auto &x : input)
+    x = generator();
+
+  const std::vector<ParallelSorter> sorters = {
+      {"ParallelMergesort",
+       [](std::vector<unsigned int> &a, unsigned int threads)
+       { mapra::ParallelMergesort(a, threads); }},
+      {"ParallelSamplesort",
+       [](std::vector<unsigned int> &a, unsigned int threads)
+       { mapra::ParallelSamplesort(a, threads); }},
+  };
+
+  std::cout << "algorithm,n,threads,seconds,speedup_vs_mergesort,"
+               "speedup_vs_quicksort_median3\n";
+  const double mergesort = TimeSort(input, mapra::Mergesort);
+  const double quicksort = TimeSort(input, mapra::QuicksortMedian3);
+  std::cout << "Mergesort," << n << ",1," << mergesort << ",1,"
+            << quicksort / mergesort << "\n";
+  std::cout << "QuicksortMedian3," << n << ",1," << quicksort << ','
+            << mergesort / quicksort << ",1\n";
+
+  for (const auto &sorter : sorters)
+  {
+    for (unsigned int threads = 1; threads <= max_threads; ++threads)
+    {
+      const double seconds = TimeSort(
+          input, [&](std::vector<unsigned int> &a)
+          { sorter.fn(a, threads); });
+      std::cout << sorter.name << ',' << n << ',' << threads << ','
+                << seconds << ',' << mergesort / seconds << ','
+                << quicksort / seconds << std::endl;
+    }
+  }
+
+  return 0;
+}
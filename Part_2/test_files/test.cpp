@@ -1,16 +1,33 @@
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <functional>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "../include/adaptive_mergesort.h"
+#include "../include/argsort.h"
 #include "../include/bubblesort.h"
+#include "../include/external_sort.h"
 #include "../include/heapsort.h"
 #include "../include/insertionsort.h"
+#include "../include/introsort.h"
 #include "../include/mergesort.h"
+#include "../include/parallel_mergesort.h"
+#include "../include/parallel_samplesort.h"
 #include "../include/quicksort_median3.h"
 #include "../include/quicksort_simple.h"
+#include "../include/radixsort.h"
 #include "../include/selectionsort.h"
+#include "../include/sort_small.h"
+#include "../include/sort_stats.h"
 
 struct Sorter
 {
@@ -39,10 +56,14 @@ void RunManualTests(const Sorter &sorter)
     auto input = manual_tests[i].first;
     const auto &expected = manual_tests[i].second;
 
+    mapra::ResetSortStats();
     sorter.fn(input);
     bool ok = (input == expected);
 
-    std::cout << "  test " << i << ": " << (ok ? "PASS" : "FAIL") << "\n";
+    std::cout << "  test " << i << ": " << (ok ? "PASS" : "FAIL");
+    if (mapra::kSortStatsEnabled)
+      std::cout << "  " << mapra::FormatSortStats();
+    std::cout << "\n";
     if (!ok)
     {
       std::cout << "    expected: ";
@@ -60,6 +81,391 @@ void RunManualTests(const Sorter &sorter)
   std::cout << sorter.name << " passed all manual tests!\n\n";
 }
 
+// Checks every SortSmall network with the 0-1 principle (all 2^n inputs of
+// 0s and 1s) and on the reversed sequence n, n-1, ..., 1.
+void RunSortSmallTests()
+{
+  std::cout << "--- SortSmall ---\n";
+
+  for (std::size_t n = 0; n <= mapra::kSortSmallMax; ++n)
+  {
+    bool ok = true;
+    std::vector<unsigned int> input(n);
+    for (unsigned long bits = 0; bits < (1ul << n); ++bits)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        input[i] = (bits >> i) & 1;
+      mapra::SortSmall(input.data(), n);
+      ok = ok && std::is_sorted(input.begin(), input.end());
+    }
+    for (std::size_t i = 0; i < n; ++i)
+      input[i] = n - i;
+    mapra::SortSmall(input.data(), n);
+    for (std::size_t i = 0; i < n; ++i)
+      ok = ok && input[i] == i + 1;
+
+    std::cout << "  n = " << n << ": " << (ok ? "PASS" : "FAIL") << "\n";
+    assert(ok && "SortSmall test failed.");
+  }
+
+  std::array<unsigned int, 5> batch = {4, 2, 5, 1, 3};
+  mapra::SortSmall(batch);
+  bool ok = (batch == std::array<unsigned int, 5>{1, 2, 3, 4, 5});
+  std::cout << "  std::array: " << (ok ? "PASS" : "FAIL") << "\n";
+  assert(ok && "SortSmall test failed.");
+
+  // The 4-key network has 5 comparators; on 4 3 2 1 the exchanges are
+  // (0,2) (1,3) (0,1) (2,3), the middle comparator (1,2) finds 2 < 3.
+  if (mapra::kSortStatsEnabled)
+  {
+    unsigned int reversed[] = {4, 3, 2, 1};
+    mapra::ResetSortStats();
+    mapra::SortSmall(reversed, 4);
+    const mapra::SortStats &stats = mapra::CurrentSortStats();
+    ok = stats.comparisons == 5 && stats.swaps == 4;
+    std::cout << "  counts: " << (ok ? "PASS" : "FAIL") << "  "
+              << mapra::FormatSortStats() << "\n";
+    assert(ok && "SortSmall counts are wrong.");
+  }
+
+  bool thrown = false;
+  unsigned int too_many[mapra::kSortSmallMax + 1] = {};
+  try
+  {
+    mapra::SortSmall(too_many, mapra::kSortSmallMax + 1);
+  }
+  catch (const std::length_error &)
+  {
+    thrown = true;
+  }
+  std::cout << "  too large: " << (thrown ? "PASS" : "FAIL") << "\n";
+  assert(thrown && "SortSmall accepted too many elements.");
+
+  std::cout << "SortSmall passed all manual tests!\n\n";
+}
+
+static std::vector<unsigned int> ReadKeyFile(const std::string &path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::vector<unsigned int> keys;
+  unsigned int key;
+  while (file.read(reinterpret_cast<char *>(&key), sizeof(key)))
+    keys.push_back(key);
+  return keys;
+}
+
+// Inputs of 10^6 keys that defeat the median-of-3 / ninther pivots. The
+// reversed sequence and Musser's median-of-3 killer drive Introsort into
+// its depth limit, so the Heapsort fallback has to finish the sort. With
+// -DMAPRA_SORT_STATS the recursion depth is checked against log2(n) + 1
+// (O(log n) stack), and the swaps, all of which come from HeapsortRange
+// (Introsort's own partition does not count them), show the fallback.
+void RunIntrosortTests()
+{
+  std::cout << "--- Introsort (adversarial) ---\n";
+
+  const std::size_t n = 1000000;
+  const std::size_t half = n / 2;
+  std::vector<unsigned int> median3_killer(n);
+  for (std::size_t i = 1; i <= half; ++i)
+  {
+    if (i % 2 == 1)
+    {
+      median3_killer[i - 1] = i;
+      median3_killer[i] = half + i;
+    }
+    median3_killer[half + i - 1] = 2 * i;
+  }
+  std::vector<unsigned int> sorted(n), reversed(n), organ_pipe(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    sorted[i] = i;
+    reversed[i] = n - i;
+    organ_pipe[i] = i < half ? i : n - i;
+  }
+
+  struct Case
+  {
+    std::string name;
+    const std::vector<unsigned int> *input;
+    bool depth_limit;
+  };
+  const std::vector<Case> cases = {{"sorted", &sorted, false},
+                                   {"reversed", &reversed, true},
+                                   {"organ pipe", &organ_pipe, false},
+                                   {"median-of-3 killer", &median3_killer,
+                                    true}};
+  std::size_t log2_n = 0;
+  for (std::size_t m = n; m > 1; m /= 2)
+    ++log2_n;
+
+  for (const Case &c : cases)
+  {
+    std::vector<unsigned int> array = *c.input;
+    std::vector<unsigned int> expected = *c.input;
+    mapra::ResetSortStats();
+    mapra::Introsort(array);
+    std::sort(expected.begin(), expected.end());
+    bool ok = array == expected;
+    if (mapra::kSortStatsEnabled)
+    {
+      const mapra::SortStats &stats = mapra::CurrentSortStats();
+      ok = ok && stats.max_depth <= log2_n + 1;
+      if (c.depth_limit)
+        ok = ok && stats.swaps > 0;
+    }
+    std::cout << "  " << c.name << ": " << (ok ? "PASS" : "FAIL");
+    if (mapra::kSortStatsEnabled)
+      std::cout << "  " << mapra::FormatSortStats();
+    std::cout << "\n";
+    assert(ok && "Introsort test failed.");
+  }
+
+  std::cout << "Introsort passed all adversarial tests!\n\n";
+}
+
+// Eight long runs, alternately ascending and descending, whose values
+// interleave in blocks of 64 (so the merges gallop), plus a few swaps.
+static std::vector<unsigned int> NearlySorted(std::size_t n)
+{
+  const std::size_t kRuns = 8;
+  const std::size_t kBlock = 64;
+  const std::size_t length = n / kRuns;
+  std::vector<unsigned int> array(n);
+  for (std::size_t r = 0; r < kRuns; ++r)
+  {
+    for (std::size_t i = 0; i < length; ++i)
+    {
+      const std::size_t j = r % 2 == 0 ? i : length - 1 - i;
+      array[r * length + i] =
+          ((j / kBlock) * kRuns + r) * kBlock + j % kBlock;
+    }
+  }
+  std::mt19937 generator(2022);
+  for (int swap = 0; swap < 16; ++swap)
+    std::swap(array[generator() % n], array[generator() % n]);
+  return array;
+}
+
+// 2^20 random keys (thousands of runs for MergeCollapse) and nearly sorted
+// inputs of 2^18 and 2^20 keys. With -DMAPRA_SORT_STATS the comparisons
+// on the nearly sorted inputs must grow linearly: 4 times the keys may
+// cost at most 4.5 times the comparisons (n log n would be 4.44 times,
+// measured: 3.98) and at most 4 comparisons per key.
+void RunAdaptiveMergesortTests()
+{
+  std::cout << "--- AdaptiveMergesort (large) ---\n";
+
+  std::mt19937 generator(2022);
+  std::vector<unsigned int> random(1 << 20);
+  for (auto &key : random)
+    key = generator();
+  std::vector<unsigned int> expected = random;
+  mapra::AdaptiveMergesort(random);
+  std::sort(expected.begin(), expected.end());
+  bool ok = random == expected;
+  std::cout << "  random: " << (ok ? "PASS" : "FAIL") << "\n";
+  assert(ok && "AdaptiveMergesort test failed.");
+
+  std::uint64_t comparisons[2] = {};
+  const std::size_t sizes[2] = {std::size_t{1} << 18, std::size_t{1} << 20};
+  for (int s = 0; s < 2; ++s)
+  {
+    std::vector<unsigned int> array = NearlySorted(sizes[s]);
+    expected = array;
+    mapra::ResetSortStats();
+    mapra::AdaptiveMergesort(array);
+    comparisons[s] = mapra::CurrentSortStats().comparisons;
+    std::sort(expected.begin(), expected.end());
+    ok = array == expected;
+    if (mapra::kSortStatsEnabled)
+      ok = ok && comparisons[s] <= 4 * sizes[s];
+    std::cout << "  nearly sorted, n = " << sizes[s] << ": "
+              << (ok ? "PASS" : "FAIL");
+    if (mapra::kSortStatsEnabled)
+      std::cout << "  " << mapra::FormatSortStats();
+    std::cout << "\n";
+    assert(ok && "AdaptiveMergesort test failed.");
+  }
+  if (mapra::kSortStatsEnabled)
+  {
+    ok = 2 * comparisons[1] <= 9 * comparisons[0];
+    std::cout << "  linear growth: " << (ok ? "PASS" : "FAIL") << "\n";
+    assert(ok && "AdaptiveMergesort is not linear on nearly sorted input.");
+  }
+
+  std::cout << "AdaptiveMergesort passed all large tests!\n\n";
+}
+
+// The manual tests are too small for the parallel code paths (e.g. the
+// fork, merge path split and buffer ping-pong of ParallelMergesort only
+// run from 2^15 keys on), so the parallel sorters also get 2^20 keys.
+void RunParallelTests(const char *name,
+                      void (*sort)(std::vector<unsigned int> &, unsigned int))
+{
+  std::cout << "--- " << name << " (large) ---\n";
+
+  std::mt19937 generator(2022);
+  std::vector<unsigned int> random(1 << 20);
+  for (auto &key : random)
+    key = generator();
+  std::vector<unsigned int> few_unique(1 << 20);
+  for (auto &key : few_unique)
+    key = generator() % 3;
+
+  for (unsigned int threads : {2u, 3u, 8u})
+  {
+    for (const auto *input : {&random, &few_unique})
+    {
+      std::vector<unsigned int> array = *input;
+      std::vector<unsigned int> expected = *input;
+      sort(array, threads);
+      std::sort(expected.begin(), expected.end());
+      const bool ok = array == expected;
+      std::cout << "  " << threads << " threads, "
+                << (input == &random ? "random" : "few unique") << ": "
+                << (ok ? "PASS" : "FAIL") << "\n";
+      assert(ok && "Parallel sorter test failed.");
+    }
+  }
+
+  std::cout << name << " passed all large tests!\n\n";
+}
+
+// Sorts a key file in memory, with a 64 KiB budget, which forces 25 runs
+// and several merge passes, and with the smallest budget (196 runs, merged
+// two at a time with 2 KiB buffers).
+void RunExternalSortTests()
+{
+  std::cout << "--- ExternalSort ---\n";
+
+  const std::filesystem::path dir = std::filesystem::temp_directory_path();
+  const std::string input = (dir / "mapra_external_in.bin").string();
+  const std::string output = (dir / "mapra_external_out.bin").string();
+
+  std::mt19937 generator(2022);
+  std::vector<unsigned int> keys(200000);
+  for (auto &key : keys)
+    key = generator() % 3 == 0 ? 0xffffffffu : generator();
+  {
+    std::ofstream file(input, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(keys.data()),
+               keys.size() * sizeof(unsigned int));
+  }
+  std::sort(keys.begin(), keys.end());
+
+  const std::vector<std::pair<std::string, std::size_t>> budgets = {
+      {"in memory", mapra::kExternalSortMemory},
+      {"64 KiB", 1 << 16},
+      {"8 KiB", mapra::kExternalSortMinMemory}};
+  for (const auto &budget : budgets)
+  {
+    mapra::ExternalSort(input, output, budget.second, dir.string());
+    const bool ok = ReadKeyFile(output) == keys;
+    std::cout << "  " << budget.first << ": " << (ok ? "PASS" : "FAIL")
+              << "\n";
+    assert(ok && "ExternalSort test failed.");
+  }
+
+  bool thrown = false;
+  try
+  {
+    mapra::ExternalSort((dir / "mapra_missing.bin").string(), output);
+  }
+  catch (const std::runtime_error &)
+  {
+    thrown = true;
+  }
+  std::cout << "  missing input: " << (thrown ? "PASS" : "FAIL") << "\n";
+  assert(thrown && "ExternalSort accepted a missing input file.");
+
+  thrown = false;
+  try
+  {
+    mapra::ExternalSort(input, output, mapra::kExternalSortMinMemory - 1);
+  }
+  catch (const std::invalid_argument &)
+  {
+    thrown = true;
+  }
+  std::cout << "  budget too small: " << (thrown ? "PASS" : "FAIL") << "\n";
+  assert(thrown && "ExternalSort accepted a budget below the minimum.");
+
+  // The input must not be truncated by opening it as the output.
+  const std::vector<unsigned int> unsorted = ReadKeyFile(input);
+  thrown = false;
+  try
+  {
+    mapra::ExternalSort(input, (dir / "." / "mapra_external_in.bin").string());
+  }
+  catch (const std::invalid_argument &)
+  {
+    thrown = true;
+  }
+  const bool unchanged = ReadKeyFile(input) == unsorted;
+  std::cout << "  output is input: " << (thrown && unchanged ? "PASS" : "FAIL")
+            << "\n";
+  assert(thrown && unchanged && "ExternalSort overwrote its input file.");
+
+  std::remove(input.c_str());
+  std::remove(output.c_str());
+  std::cout << "ExternalSort passed all manual tests!\n\n";
+}
+
+// Sorts a key column with Argsort and gathers a payload column with the
+// permutation.
+void RunArgsortTests()
+{
+  std::cout << "--- Argsort ---\n";
+
+  const std::vector<unsigned int> keys = {3, 1, 4, 1, 5, 9, 2, 6, 0xffffffffu};
+  std::vector<std::string> names = {"three", "one",  "four", "one'", "five",
+                                    "nine",  "two",  "six",  "max"};
+  const std::vector<std::uint32_t> order = mapra::Argsort(keys);
+  bool ok = order == std::vector<std::uint32_t>{1, 3, 6, 0, 2, 4, 7, 5, 8};
+  std::cout << "  manual: " << (ok ? "PASS" : "FAIL") << "\n";
+  assert(ok && "Argsort test failed.");
+
+  mapra::ApplyPermutation(names, order);
+  ok = names == std::vector<std::string>{"one",  "one'", "two", "three",
+                                         "four", "five", "six", "nine",
+                                         "max"};
+  std::cout << "  ApplyPermutation: " << (ok ? "PASS" : "FAIL") << "\n";
+  assert(ok && "ApplyPermutation test failed.");
+
+  // Many duplicates: the permutation must sort the keys and keep equal
+  // keys in input order.
+  std::mt19937 generator(2022);
+  std::vector<unsigned int> random(1 << 20);
+  for (auto &key : random)
+    key = generator() % 1000 * 4294967u;
+  const std::vector<std::uint32_t> permutation = mapra::Argsort(random);
+  std::vector<unsigned int> gathered = random;
+  mapra::ApplyPermutation(gathered, permutation);
+  std::vector<unsigned int> expected = random;
+  std::sort(expected.begin(), expected.end());
+  ok = gathered == expected;
+  for (std::size_t i = 1; i < permutation.size() && ok; ++i)
+    ok = random[permutation[i - 1]] != random[permutation[i]] ||
+         permutation[i - 1] < permutation[i];
+  std::cout << "  random, stable: " << (ok ? "PASS" : "FAIL") << "\n";
+  assert(ok && "Argsort test failed.");
+
+  bool thrown = false;
+  try
+  {
+    mapra::ApplyPermutation(names, std::vector<std::uint32_t>{0, 1});
+  }
+  catch (const std::invalid_argument &)
+  {
+    thrown = true;
+  }
+  std::cout << "  size mismatch: " << (thrown ? "PASS" : "FAIL") << "\n";
+  assert(thrown && "ApplyPermutation accepted a wrong size.");
+
+  std::cout << "Argsort passed all manual tests!\n\n";
+}
+
 int main()
 {
   std::vector<Sorter> algorithms = {
@@ -67,15 +473,34 @@ int main()
       {"SelectionSort", mapra::Selectionsort},
       {"InsertionSort", mapra::Insertionsort},
       {"HeapSort", mapra::Heapsort},
+      {"BottomUpHeapsort", mapra::BottomUpHeapsort},
+      {"4-aryHeapsort", mapra::DaryHeapsort<4>},
+      {"8-aryHeapsort", mapra::DaryHeapsort<8>},
       {"QuicksortSimple", mapra::QuicksortSimple},
       {"QuicksortMedian3", mapra::QuicksortMedian3},
+      {"QuicksortSimpleBranchless", mapra::QuicksortSimpleBranchless},
+      {"QuicksortMedian3Branchless", mapra::QuicksortMedian3Branchless},
       {"Mergesort", mapra::Mergesort},
+      {"Introsort", mapra::Introsort},
+      {"RadixSort", mapra::RadixSort},
+      {"ParallelMergesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelMergesort(a); }},
+      {"ParallelSamplesort", [](std::vector<unsigned int> &a)
+       { mapra::ParallelSamplesort(a); }},
+      {"AdaptiveMergesort", mapra::AdaptiveMergesort},
   };
 
   for (const auto &s : algorithms)
   {
     RunManualTests(s);
   }
+  RunSortSmallTests();
+  RunIntrosortTests();
+  RunAdaptiveMergesortTests();
+  RunParallelTests("ParallelMergesort", mapra::ParallelMergesort);
+  RunParallelTests("ParallelSamplesort", mapra::ParallelSamplesort);
+  RunExternalSortTests();
+  RunArgsortTests();
 
   return 0;
 }
@@ -0,0 +1,106 @@
+#ifndef MAPRA_ARGSORT_H_
+#define MAPRA_ARGSORT_H_
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility> // for std::move
+#include <vector>
+
+namespace mapra
+{
+
+  // What the sorters move around in an argsort: a pointer to the key and
+  // the key's position in the input, 16 bytes no matter how large T is.
+  // Compares like the keys; equal keys are ordered by index, so every
+  // sorter yields the stable order.
+  template <typename T>
+  struct KeyIndex
+  {
+    // A sorter for the entries, e.g. Mergesort<KeyIndex<T>>.
+    using Sorter = void (*)(std::vector<KeyIndex> &);
+
+    const T *key;
+    std::uint32_t index;
+  };
+
+  template <typename T>
+  bool operator<(const KeyIndex<T> &lhs, const KeyIndex<T> &rhs)
+  {
+    if (*lhs.key < *rhs.key)
+      return true;
+    if (*rhs.key < *lhs.key)
+      return false;
+    return lhs.index < rhs.index;
+  }
+
+  template <typename T>
+  bool operator>(const KeyIndex<T> &lhs, const KeyIndex<T> &rhs)
+  {
+    return rhs < lhs;
+  }
+
+  // The indices differ, so "<=" is "<".
+  template <typename T>
+  bool operator<=(const KeyIndex<T> &lhs, const KeyIndex<T> &rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  template <typename T>
+  bool operator>=(const KeyIndex<T> &lhs, const KeyIndex<T> &rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+  // Returns the permutation p that sorts keys, i.e. keys[p[0]] <=
+  // keys[p[1]] <= ..., without moving the keys. `sort` is any sorter for
+  // std::vector<KeyIndex<T>>, e.g.
+  //   Argsort(students, Selectionsort<KeyIndex<Student>>)
+  // Bubblesort, Selectionsort and Mergesort are instantiated for the
+  // KeyIndex of double, std::string and Student.
+  template <typename T>
+  std::vector<std::uint32_t> Argsort(const std::vector<T> &keys,
+                                     typename KeyIndex<T>::Sorter sort)
+  {
+    if (keys.size() > std::numeric_limits<std::uint32_t>::max())
+      throw std::length_error("Argsort: more than 2^32 - 1 keys");
+
+    std::vector<KeyIndex<T>> items(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i)
+      items[i] = {&keys[i], static_cast<std::uint32_t>(i)};
+    sort(items);
+
+    std::vector<std::uint32_t> permutation(items.size());
+    for (std::size_t i = 0; i < items.size(); ++i)
+      permutation[i] = items[i].index;
+    return permutation;
+  }
+
+  // Rearranges array to array[p[0]], array[p[1]], ... in one gather pass;
+  // p must be a permutation of 0, ..., n - 1 (e.g. the result of Argsort).
+  // The writes are sequential and every element is moved, not copied;
+  // the random reads are prefetched a few elements ahead.
+  template <typename T>
+  void ApplyPermutation(std::vector<T> &array,
+                        const std::vector<std::uint32_t> &permutation)
+  {
+    if (permutation.size() != array.size())
+      throw std::invalid_argument(
+          "ApplyPermutation: permutation and array differ in size");
+
+    const std::size_t kPrefetchDistance = 8;
+    std::vector<T> sorted;
+    sorted.reserve(array.size());
+    for (std::size_t i = 0; i < permutation.size(); ++i)
+    {
+      if (i + kPrefetchDistance < permutation.size())
+        __builtin_prefetch(&array[permutation[i + kPrefetchDistance]]);
+      sorted.push_back(std::move(array[permutation[i]]));
+    }
+    array.swap(sorted);
+  }
+
+} // namespace mapra
+
+#endif // MAPRA_ARGSORT_H_
@@ -0,0 +1,55 @@
+#ifndef MAPRA_BULK_WRITER_H_
+#define MAPRA_BULK_WRITER_H_
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.h"
+
+namespace mapra
+{
+
+  // Formats into a large reusable buffer and hands it to the stream in a
+  // few big writes. Numbers are formatted with std::to_chars exactly as
+  // operator<< does with the default stream settings (doubles like "%g"
+  // with precision 6), so the output is byte-identical to Print.
+  // The buffer is flushed when it is full, by Flush() and on destruction.
+  class BulkWriter
+  {
+  public:
+    explicit BulkWriter(std::ostream &os,
+                        std::size_t buffer_bytes = std::size_t{1} << 20);
+    BulkWriter(const BulkWriter &) = delete;
+    BulkWriter &operator=(const BulkWriter &) = delete;
+    ~BulkWriter();
+
+    void Write(char c);
+    void Write(std::string_view text);
+    void Write(int value);
+    void Write(double value);
+    // "first_name last_name matr_nr grade", like operator<<(Student).
+    void Write(const Student &student);
+
+    void Flush();
+
+  private:
+    // Flushes unless `bytes` more bytes fit into the buffer.
+    void Reserve(std::size_t bytes);
+
+    std::ostream &os_;
+    std::vector<char> buffer_;
+    std::size_t size_ = 0;
+  };
+
+  // Same output as Print(os, array): one element per line.
+  void BulkPrint(std::ostream &os, const std::vector<double> &array);
+  void BulkPrint(std::ostream &os, const std::vector<std::string> &array);
+  void BulkPrint(std::ostream &os, const std::vector<std::string_view> &array);
+  void BulkPrint(std::ostream &os, const std::vector<Student> &array);
+
+} // namespace mapra
+
+#endif // MAPRA_BULK_WRITER_H_
@@ -0,0 +1,142 @@
+#ifndef MAPRA_GENERIC_SORT_H_
+#define MAPRA_GENERIC_SORT_H_
+
+#include <algorithm>  // for std::iter_swap, std::move
+#include <functional> // for std::invoke, std::less
+#include <iterator>
+#include <type_traits>
+#include <utility> // for std::forward, std::move
+#include <vector>
+
+namespace mapra
+{
+
+  // Header-only versions of Bubblesort, Selectionsort and Mergesort for a
+  // random-access range [first, last) of any type. comp(a, b) is a strict
+  // weak order ("a before b"), proj maps an element to the key that is
+  // compared, e.g.
+  //   Mergesort(v.begin(), v.end(), std::less<>{}, &Student::grade);
+  // Both are called through std::invoke, so member pointers work as well.
+  // With the defaults (std::less<>, Identity) they sort like the vector
+  // overloads, but the comparison is visible to the compiler and can be
+  // inlined.
+
+  // The default projection: returns its argument unchanged.
+  struct Identity
+  {
+    template <typename T>
+    constexpr T &&operator()(T &&x) const noexcept
+    {
+      return std::forward<T>(x);
+    }
+  };
+
+  template <typename RandomIt, typename Compare = std::less<>,
+            typename Projection = Identity>
+  void Bubblesort(RandomIt first, RandomIt last, Compare comp = {},
+                  Projection proj = {})
+  {
+    for (RandomIt end = last; end - first > 1; --end)
+    {
+      bool swapped = false;
+      for (RandomIt i = first; i + 1 != end; ++i)
+      {
+        if (std::invoke(comp, std::invoke(proj, *(i + 1)),
+                        std::invoke(proj, *i)))
+        {
+          std::iter_swap(i, i + 1);
+          swapped = true;
+        }
+      }
+      if (!swapped) // already sorted
+        break;
+    }
+  }
+
+  template <typename RandomIt, typename Compare = std::less<>,
+            typename Projection = Identity>
+  void Selectionsort(RandomIt first, RandomIt last, Compare comp = {},
+                     Projection proj = {})
+  {
+    for (RandomIt i = first; last - i > 1; ++i)
+    {
+      RandomIt min = i;
+      for (RandomIt j = i + 1; j != last; ++j)
+      {
+        if (std::invoke(comp, std::invoke(proj, *j), std::invoke(proj, *min)))
+          min = j;
+      }
+      if (min != i)
+        std::iter_swap(i, min);
+    }
+  }
+
+  namespace detail
+  {
+
+    // Whether a merge takes the left element before the right one. With
+    // the defaults this is "left <= right", exactly what
+    // Mergesort(std::vector<T> &) does; for Student "<=" also compares
+    // matr_nr and grade, so equal names with different records take the
+    // right element first there. With any other comparator or projection
+    // ties take the left element, which makes the sort stable.
+    template <typename T, typename Compare, typename Projection>
+    bool TakeLeft(const T &left, const T &right, Compare &comp,
+                  Projection &proj)
+    {
+      if constexpr (std::is_same_v<Compare, std::less<>> &&
+                    std::is_same_v<Projection, Identity>)
+        return left <= right;
+      else
+        return !std::invoke(comp, std::invoke(proj, right),
+                            std::invoke(proj, left));
+    }
+
+    // Sorts [first, last); `buffer` is scratch space for the left halves.
+    template <typename RandomIt, typename Buffer, typename Compare,
+              typename Projection>
+    void Mergesort(RandomIt first, RandomIt last, Buffer &buffer,
+                   Compare &comp, Projection &proj)
+    {
+      if (last - first <= 1)
+        return;
+      const RandomIt mid = first + (last - first) / 2;
+      Mergesort(first, mid, buffer, comp, proj);
+      Mergesort(mid, last, buffer, comp, proj);
+
+      // Only the left half is moved out; the merge writes to the front of
+      // the range and can never overtake the unread part of the right half.
+      buffer.assign(std::make_move_iterator(first),
+                    std::make_move_iterator(mid));
+      auto i = buffer.begin();
+      RandomIt j = mid;
+      RandomIt out = first;
+      while (i != buffer.end() && j != last)
+      {
+        if (TakeLeft(*i, *j, comp, proj))
+          *out++ = std::move(*i++);
+        else
+          *out++ = std::move(*j++);
+      }
+      std::move(i, buffer.end(), out);
+    }
+
+  } // namespace detail
+
+  // Needs a buffer of n / 2 elements. With the default comparator and
+  // projection the result equals Mergesort(std::vector<T> &), which merges
+  // with "<=" (see TakeLeft); with a custom comparator or projection the
+  // sort is stable.
+  template <typename RandomIt, typename Compare = std::less<>,
+            typename Projection = Identity>
+  void Mergesort(RandomIt first, RandomIt last, Compare comp = {},
+                 Projection proj = {})
+  {
+    std::vector<typename std::iterator_traits<RandomIt>::value_type> buffer;
+    buffer.reserve((last - first) / 2);
+    detail::Mergesort(first, last, buffer, comp, proj);
+  }
+
+} // namespace mapra
+
+#endif // MAPRA_GENERIC_SORT_H_
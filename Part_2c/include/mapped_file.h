@@ -0,0 +1,58 @@
+#ifndef MAPRA_MAPPED_FILE_H_
+#define MAPRA_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "student.h"
+
+namespace mapra
+{
+
+  // Read-only memory mapping of a whole file. The string_views handed out
+  // by the readers below point into the mapping and are only valid as long
+  // as the MappedFile lives. Throws std::runtime_error if the file cannot
+  // be opened or mapped.
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    ~MappedFile();
+
+    std::string_view contents() const { return {data_, size_}; }
+
+  private:
+    const char *data_ = nullptr;
+    std::size_t size_ = 0;
+  };
+
+  // A Student whose names point into the text it was read from.
+  struct StudentView
+  {
+    std::string_view first_name;
+    std::string_view last_name;
+    int matr_nr;
+    double grade;
+
+    Student ToStudent() const;
+  };
+
+  // Replacements for Read(ifs, array) that parse text, e.g.
+  // MappedFile::contents(), without streams or locales. Like Read they
+  // append the whitespace-separated elements to the back of array and
+  // stop at the first element that cannot be parsed. Numbers are parsed
+  // with std::from_chars, strings are views into the text.
+  void ReadDoubles(std::string_view text, std::vector<double> &array);
+  void ReadStrings(std::string_view text,
+                   std::vector<std::string_view> &array);
+  void ReadStudents(std::string_view text, std::vector<StudentView> &array);
+
+} // namespace mapra
+
+#endif // MAPRA_MAPPED_FILE_H_
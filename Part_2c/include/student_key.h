@@ -0,0 +1,49 @@
+#ifndef MAPRA_STUDENT_KEY_H_
+#define MAPRA_STUDENT_KEY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "student.h"
+
+namespace mapra
+{
+
+  // Precomputed sort key of a Student (Schwartzian transform): the first
+  // 8 bytes of last_name and first_name packed big-endian into integers,
+  // zero-padded, so that comparing the integers orders like comparing the
+  // strings as far as the prefixes go. Only if a prefix ties, the full
+  // names are compared.
+  //
+  // The operators agree with the ones of Student for every pair: "<" and
+  // ">" order by last and first name, "==" compares all four fields of
+  // the records, "<=" is "<" or "==". A sorter therefore takes the same
+  // decisions on the keys as on the records.
+  struct StudentKey
+  {
+    std::uint64_t last_prefix;
+    std::uint64_t first_prefix;
+    const Student *student;
+  };
+
+  StudentKey MakeStudentKey(const Student &student);
+
+  bool operator<(const StudentKey &lhs, const StudentKey &rhs);
+  bool operator>(const StudentKey &lhs, const StudentKey &rhs);
+  bool operator==(const StudentKey &lhs, const StudentKey &rhs);
+  bool operator!=(const StudentKey &lhs, const StudentKey &rhs);
+  bool operator<=(const StudentKey &lhs, const StudentKey &rhs);
+  bool operator>=(const StudentKey &lhs, const StudentKey &rhs);
+
+  // Sorts students exactly like sort(students) with the matching
+  // std::vector<Student> sorter would, e.g.
+  //   KeyedSort(students, Mergesort<StudentKey>)
+  // but sorts an array of keys and then moves every record once.
+  // Bubblesort, Selectionsort and Mergesort are instantiated for
+  // StudentKey.
+  void KeyedSort(std::vector<Student> &students,
+                 void (*sort)(std::vector<StudentKey> &));
+
+} // namespace mapra
+
+#endif // MAPRA_STUDENT_KEY_H_
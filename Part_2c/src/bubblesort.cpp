@@ -4,7 +4,9 @@
 #include <utility> // for std::swap
 #include <vector>
 
+#include "../include/argsort.h"
 #include "../include/student.h"
+#include "../include/student_key.h"
 
 namespace mapra
 {
@@ -34,5 +36,9 @@ namespace mapra
   template void Bubblesort(std::vector<double> &);
   template void Bubblesort(std::vector<std::string> &);
   template void Bubblesort(std::vector<Student> &);
+  template void Bubblesort(std::vector<KeyIndex<double>> &);
+  template void Bubblesort(std::vector<KeyIndex<std::string>> &);
+  template void Bubblesort(std::vector<KeyIndex<Student>> &);
+  template void Bubblesort(std::vector<StudentKey> &);
 
 } // namespace mapra
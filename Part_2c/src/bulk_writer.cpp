@@ -0,0 +1,114 @@
+#include "../include/bulk_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace mapra
+{
+
+  // Longest output of to_chars for an int or a double in "%.6g" format,
+  // e.g. "-1.23457e-308".
+  static const std::size_t kMaxNumberChars = 32;
+  // Default precision of a std::ostream.
+  static const int kDoublePrecision = 6;
+
+  BulkWriter::BulkWriter(std::ostream &os, std::size_t buffer_bytes)
+      : os_(os), buffer_(std::max(buffer_bytes, kMaxNumberChars))
+  {
+  }
+
+  BulkWriter::~BulkWriter() { Flush(); }
+
+  void BulkWriter::Flush()
+  {
+    os_.write(buffer_.data(), size_);
+    size_ = 0;
+  }
+
+  void BulkWriter::Reserve(std::size_t bytes)
+  {
+    if (buffer_.size() - size_ < bytes)
+      Flush();
+  }
+
+  void BulkWriter::Write(char c)
+  {
+    Reserve(1);
+    buffer_[size_++] = c;
+  }
+
+  void BulkWriter::Write(std::string_view text)
+  {
+    if (text.size() > buffer_.size())
+    {
+      Flush();
+      os_.write(text.data(), text.size());
+      return;
+    }
+    Reserve(text.size());
+    std::memcpy(buffer_.data() + size_, text.data(), text.size());
+    size_ += text.size();
+  }
+
+  void BulkWriter::Write(int value)
+  {
+    Reserve(kMaxNumberChars);
+    char *begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxNumberChars, value).ptr -
+            buffer_.data();
+  }
+
+  void BulkWriter::Write(double value)
+  {
+    Reserve(kMaxNumberChars);
+    char *begin = buffer_.data() + size_;
+    size_ = std::to_chars(begin, begin + kMaxNumberChars, value,
+                          std::chars_format::general, kDoublePrecision)
+                .ptr -
+            buffer_.data();
+  }
+
+  void BulkWriter::Write(const Student &student)
+  {
+    Write(student.first_name);
+    Write(' ');
+    Write(student.last_name);
+    Write(' ');
+    Write(student.matr_nr);
+    Write(' ');
+    Write(student.grade);
+  }
+
+  template <typename T>
+  static void PrintLines(std::ostream &os, const std::vector<T> &array)
+  {
+    BulkWriter writer(os);
+    for (const auto &x : array)
+    {
+      writer.Write(x);
+      writer.Write('\n');
+    }
+  }
+
+  void BulkPrint(std::ostream &os, const std::vector<double> &array)
+  {
+    PrintLines(os, array);
+  }
+
+  void BulkPrint(std::ostream &os, const std::vector<std::string> &array)
+  {
+    PrintLines(os, array);
+  }
+
+  void BulkPrint(std::ostream &os, const std::vector<std::string_view> &array)
+  {
+    PrintLines(os, array);
+  }
+
+  void BulkPrint(std::ostream &os, const std::vector<Student> &array)
+  {
+    PrintLines(os, array);
+  }
+
+} // namespace mapra
@@ -0,0 +1,167 @@
+#include "../include/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <utility> // for std::swap
+
+namespace mapra
+{
+
+  static std::runtime_error MapError(const std::string &what,
+                                     const std::string &path)
+  {
+    return std::runtime_error("MappedFile: cannot " + what + " " + path +
+                              ": " + std::strerror(errno));
+  }
+
+  MappedFile::MappedFile(const std::string &path)
+  {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw MapError("open", path);
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+      const std::runtime_error error = MapError("stat", path);
+      close(fd);
+      throw error;
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ > 0) // mmap rejects empty mappings
+    {
+      void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+      {
+        const std::runtime_error error = MapError("map", path);
+        close(fd);
+        throw error;
+      }
+      madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char *>(data);
+    }
+    close(fd); // the mapping keeps the file open
+  }
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept
+      : data_(other.data_), size_(other.size_)
+  {
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+  {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    return *this;
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (data_)
+      munmap(const_cast<char *>(data_), size_);
+  }
+
+  Student StudentView::ToStudent() const
+  {
+    return {std::string(first_name), std::string(last_name), matr_nr, grade};
+  }
+
+  // Whitespace as skipped by operator>> in the "C" locale.
+  static bool IsSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+           c == '\f';
+  }
+
+  static void SkipSpace(const char *&pos, const char *end)
+  {
+    while (pos < end && IsSpace(*pos))
+      ++pos;
+  }
+
+  static bool ParseWord(const char *&pos, const char *end,
+                        std::string_view &word)
+  {
+    SkipSpace(pos, end);
+    const char *begin = pos;
+    while (pos < end && !IsSpace(*pos))
+      ++pos;
+    word = std::string_view(begin, pos - begin);
+    return pos > begin;
+  }
+
+  // Parses the longest number at pos, like operator>>. Unlike
+  // std::from_chars, operator>> accepts a leading '+', but it rejects
+  // "inf", "nan" and a second sign as in "+-5". So after the optional
+  // sign only a digit or '.' may follow.
+  template <typename Number>
+  static bool ParseNumber(const char *&pos, const char *end, Number &value)
+  {
+    SkipSpace(pos, end);
+    const char *digits = pos;
+    if (digits < end && (*digits == '+' || *digits == '-'))
+      ++digits;
+    if (digits == end ||
+        !((*digits >= '0' && *digits <= '9') || *digits == '.'))
+      return false;
+    if (*pos == '+')
+      ++pos;
+    const std::from_chars_result result = std::from_chars(pos, end, value);
+    if (result.ec != std::errc())
+      return false;
+    pos = result.ptr;
+    return true;
+  }
+
+  // Room for one element per line, the usual layout of the input files.
+  template <typename T>
+  static void ReserveLines(std::string_view text, std::vector<T> &array)
+  {
+    array.reserve(array.size() + 1 +
+                  std::count(text.begin(), text.end(), '\n'));
+  }
+
+  void ReadDoubles(std::string_view text, std::vector<double> &array)
+  {
+    ReserveLines(text, array);
+    const char *pos = text.data();
+    const char *end = pos + text.size();
+    double value;
+    while (ParseNumber(pos, end, value))
+      array.push_back(value);
+  }
+
+  void ReadStrings(std::string_view text,
+                   std::vector<std::string_view> &array)
+  {
+    ReserveLines(text, array);
+    const char *pos = text.data();
+    const char *end = pos + text.size();
+    std::string_view word;
+    while (ParseWord(pos, end, word))
+      array.push_back(word);
+  }
+
+  void ReadStudents(std::string_view text, std::vector<StudentView> &array)
+  {
+    ReserveLines(text, array);
+    const char *pos = text.data();
+    const char *end = pos + text.size();
+    StudentView student;
+    while (ParseWord(pos, end, student.first_name) &&
+           ParseWord(pos, end, student.last_name) &&
+           ParseNumber(pos, end, student.matr_nr) &&
+           ParseNumber(pos, end, student.grade))
+      array.push_back(student);
+  }
+
+} // namespace mapra
@@ -1,35 +1,58 @@
 #include "../include/mergesort.h"
 
+#include <memory> // for std::allocator, std::uninitialized_move
 #include <string>
+#include <utility> // for std::move
 #include <vector>
 
+#include "../include/argsort.h"
 #include "../include/student.h"
+#include "../include/student_key.h"
 
 namespace mapra
 {
 
+  // Uninitialized storage for `size` elements of T.
+  template <typename T>
+  class ScratchBuffer
+  {
+  public:
+    explicit ScratchBuffer(std::size_t size)
+        : data_(std::allocator<T>().allocate(size)), size_(size) {}
+    ScratchBuffer(const ScratchBuffer &) = delete;
+    ScratchBuffer &operator=(const ScratchBuffer &) = delete;
+    ~ScratchBuffer() { std::allocator<T>().deallocate(data_, size_); }
+
+    T *data() const { return data_; }
+
+  private:
+    T *data_;
+    std::size_t size_;
+  };
+
+  // Merges a[lo, mid) and a[mid, hi). Only the left run is moved out into
+  // tmp; the merge fills a[lo, hi) from the front and never overtakes the
+  // unread part of the right run, which therefore stays where it is.
+  // Elements are moved, never copied, so strings keep their heap buffers.
   template <typename T>
   static void Merge(std::vector<T> &a, std::size_t lo, std::size_t mid,
-                    std::size_t hi, std::vector<T> &tmp)
+                    std::size_t hi, T *tmp)
   {
-    std::size_t i = lo, j = mid, k = lo;
-    while (i < mid && j < hi)
-    {
-      tmp[k++] = (a[i] <= a[j] ? a[i++] : a[j++]);
-    }
-    while (i < mid)
-      tmp[k++] = a[i++];
-    while (j < hi)
-      tmp[k++] = a[j++];
-    for (std::size_t x = lo; x < hi; ++x)
+    T *i = tmp;
+    T *const left_end =
+        std::uninitialized_move(a.begin() + lo, a.begin() + mid, tmp);
+    std::size_t j = mid, k = lo;
+    while (i < left_end && j < hi)
     {
-      a[x] = tmp[x];
+      a[k++] = (*i <= a[j] ? std::move(*i++) : std::move(a[j++]));
     }
+    while (i < left_end)
+      a[k++] = std::move(*i++);
+    std::destroy(tmp, left_end);
   }
 
   template <typename T>
-  static void MS(std::vector<T> &a, std::size_t lo, std::size_t hi,
-                 std::vector<T> &tmp)
+  static void MS(std::vector<T> &a, std::size_t lo, std::size_t hi, T *tmp)
   {
     if (hi - lo <= 1)
       return;
@@ -42,13 +65,17 @@ namespace mapra
   template <typename T>
   void Mergesort(std::vector<T> &array)
   {
-    std::vector<T> tmp(array.size());
-    MS(array, 0, array.size(), tmp);
+    ScratchBuffer<T> tmp(array.size() / 2); // the longest left run
+    MS(array, 0, array.size(), tmp.data());
   }
 
   // Explicit template instantiations
   template void Mergesort(std::vector<double> &);
   template void Mergesort(std::vector<std::string> &);
   template void Mergesort(std::vector<Student> &);
+  template void Mergesort(std::vector<KeyIndex<double>> &);
+  template void Mergesort(std::vector<KeyIndex<std::string>> &);
+  template void Mergesort(std::vector<KeyIndex<Student>> &);
+  template void Mergesort(std::vector<StudentKey> &);
 
 } // namespace mapra
@@ -4,7 +4,9 @@
 #include <utility> // for std::swap
 #include <vector>
 
+#include "../include/argsort.h"
 #include "../include/student.h"
+#include "../include/student_key.h"
 
 namespace mapra
 {
@@ -34,5 +36,9 @@ namespace mapra
   template void Selectionsort(std::vector<double> &);
   template void Selectionsort(std::vector<std::string> &);
   template void Selectionsort(std::vector<Student> &);
+  template void Selectionsort(std::vector<KeyIndex<double>> &);
+  template void Selectionsort(std::vector<KeyIndex<std::string>> &);
+  template void Selectionsort(std::vector<KeyIndex<Student>> &);
+  template void Selectionsort(std::vector<StudentKey> &);
 
 } // namespace mapra
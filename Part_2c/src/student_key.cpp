@@ -0,0 +1,91 @@
+#include "../include/student_key.h"
+
+#include <string>
+#include <utility> // for std::move
+
+namespace mapra
+{
+
+  // The first 8 bytes of s, big-endian, padded with zero bytes. Prefix
+  // order never contradicts std::string order, which compares the bytes
+  // as unsigned char: a shorter string has 0 where the longer one has a
+  // byte >= 0.
+  static std::uint64_t Prefix(const std::string &s)
+  {
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      const unsigned char byte = i < s.size() ? s[i] : 0;
+      prefix = prefix << 8 | byte;
+    }
+    return prefix;
+  }
+
+  StudentKey MakeStudentKey(const Student &student)
+  {
+    return {Prefix(student.last_name), Prefix(student.first_name), &student};
+  }
+
+  // Three-way comparison by last name, then first name.
+  static int CompareNames(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    if (lhs.last_prefix != rhs.last_prefix)
+      return lhs.last_prefix < rhs.last_prefix ? -1 : 1;
+    if (const int c = lhs.student->last_name.compare(rhs.student->last_name))
+      return c;
+    if (lhs.first_prefix != rhs.first_prefix)
+      return lhs.first_prefix < rhs.first_prefix ? -1 : 1;
+    return lhs.student->first_name.compare(rhs.student->first_name);
+  }
+
+  bool operator<(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    return CompareNames(lhs, rhs) < 0;
+  }
+
+  bool operator>(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    return CompareNames(lhs, rhs) > 0;
+  }
+
+  bool operator==(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    return *lhs.student == *rhs.student;
+  }
+
+  bool operator!=(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  // Student's "<=" is "<" or "==": names that tie only count as "<=" if
+  // matr_nr and grade match as well.
+  bool operator<=(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    const int c = CompareNames(lhs, rhs);
+    return c < 0 || (c == 0 && lhs == rhs);
+  }
+
+  bool operator>=(const StudentKey &lhs, const StudentKey &rhs)
+  {
+    const int c = CompareNames(lhs, rhs);
+    return c > 0 || (c == 0 && lhs == rhs);
+  }
+
+  void KeyedSort(std::vector<Student> &students,
+                 void (*sort)(std::vector<StudentKey> &))
+  {
+    std::vector<StudentKey> keys;
+    keys.reserve(students.size());
+    for (const Student &student : students)
+      keys.push_back(MakeStudentKey(student));
+    sort(keys);
+
+    std::vector<Student> sorted;
+    sorted.reserve(students.size());
+    for (const StudentKey &key : keys)
+      sorted.push_back(std::move(students[key.student - students.data()]));
+    students.swap(sorted);
+  }
+
+} // namespace mapra
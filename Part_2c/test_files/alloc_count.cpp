@@ -0,0 +1,64 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../include/io.h"
+#include "../include/mergesort.h"
+#include "../include/student.h"
+
+// Counts the heap allocations of Mergesort on test_files/studenten.txt,
+// scaled up to n records (default 10^6). Each copy of a record gets its
+// number appended to the first name, so the names are unique and too long
+// for the small string optimization: copying a Student really allocates.
+// Usage: ./alloc_count [n = 1000000]
+
+static std::size_t allocations = 0;
+static std::size_t allocated_bytes = 0;
+
+void *operator new(std::size_t size)
+{
+  ++allocations;
+  allocated_bytes += size;
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char *argv[])
+{
+  const std::size_t n = argc > 1 ? std::stoull(argv[1]) : 1000000;
+
+  std::ifstream file("test_files/studenten.txt");
+  std::vector<mapra::Student> records;
+  mapra::Read(file, records);
+  if (records.empty())
+  {
+    std::cerr << "Error: could not read test_files/studenten.txt\n";
+    return 1;
+  }
+
+  std::vector<mapra::Student> students;
+  students.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    students.push_back(records[i % records.size()]);
+    students.back().first_name += "-" + std::to_string(i);
+  }
+  std::mt19937 generator(2022);
+  for (std::size_t i = n; i > 1; --i) // Fisher-Yates
+    std::swap(students[i - 1], students[generator() % i]);
+
+  allocations = 0;
+  allocated_bytes = 0;
+  mapra::Mergesort(students);
+  std::cout << "Mergesort of " << n << " students: " << allocations
+            << " allocations, " << allocated_bytes << " bytes\n";
+  return 0;
+}
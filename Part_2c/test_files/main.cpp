@@ -8,6 +8,7 @@
 
 // Include sort algorithms
 #include "../include/bubblesort.h"
+#include "../include/bulk_writer.h"
 #include "../include/io.h"
 #include "../include/mergesort.h"
 #include "../include/selectionsort.h"
@@ -70,11 +71,11 @@ int main()
 
   // 5) Print results
   std::cout << "\n-- Sorted doubles --\n";
-  mapra::Print(std::cout, vd);
+  mapra::BulkPrint(std::cout, vd);
   std::cout << "-- Sorted strings --\n";
-  mapra::Print(std::cout, vs);
+  mapra::BulkPrint(std::cout, vs);
   std::cout << "-- Sorted students --\n";
-  mapra::Print(std::cout, vst);
+  mapra::BulkPrint(std::cout, vst);
 
   // 6) Verify
   if (!mapra::CheckSolution(vd))
@@ -1,11 +1,253 @@
+#include <cstdint>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "../include/argsort.h"
 #include "../include/bubblesort.h"
+#include "../include/bulk_writer.h"
+#include "../include/generic_sort.h"
 #include "../include/io.h"
+#include "../include/mapped_file.h"
+#include "../include/mapra_test.h"
 #include "../include/mergesort.h"
 #include "../include/selectionsort.h"
 #include "../include/student.h"
+#include "../include/student_key.h"
+
+// The iterator templates of generic_sort.h against the vector overloads.
+void TestGenericSort()
+{
+  mapra::MapraTest test("GenericSort");
+  std::mt19937 generator(2022);
+  std::vector<double> doubles(500);
+  for (auto &x : doubles)
+    x = static_cast<double>(generator() % 1000) / 8.0;
+  std::vector<std::string> strings(500);
+  for (auto &s : strings)
+    s = std::to_string(generator() % 1000);
+  std::vector<mapra::Student> students(500);
+  for (std::size_t i = 0; i < students.size(); ++i)
+    students[i] = {"Vorname" + std::to_string(i),
+                   "Name" + std::to_string(generator() % 100),
+                   static_cast<int>(i), 1.0 + (generator() % 31) / 10.0};
+
+  auto expect_same = [&test](const std::string &name, auto array, auto sort,
+                             auto generic_sort)
+  {
+    auto expected = array;
+    sort(expected);
+    generic_sort(array.begin(), array.end());
+    test.Assert(name, expected == array);
+  };
+  expect_same("Bubblesort (double)", doubles,
+              [](auto &a) { mapra::Bubblesort(a); },
+              [](auto first, auto last) { mapra::Bubblesort(first, last); });
+  expect_same("Selectionsort (string)", strings,
+              [](auto &a) { mapra::Selectionsort(a); },
+              [](auto first, auto last) { mapra::Selectionsort(first, last); });
+  expect_same("Mergesort (double)", doubles,
+              [](auto &a) { mapra::Mergesort(a); },
+              [](auto first, auto last) { mapra::Mergesort(first, last); });
+  expect_same("Mergesort (string)", strings,
+              [](auto &a) { mapra::Mergesort(a); },
+              [](auto first, auto last) { mapra::Mergesort(first, last); });
+  expect_same("Mergesort (Student)", students,
+              [](auto &a) { mapra::Mergesort(a); },
+              [](auto first, auto last) { mapra::Mergesort(first, last); });
+
+  // Equal names with different records: the defaults must reproduce the
+  // "<=" merge of Mergesort(std::vector<Student> &), which takes the right
+  // student first unless all four fields match.
+  std::vector<mapra::Student> namesakes(500);
+  for (std::size_t i = 0; i < namesakes.size(); ++i)
+    namesakes[i] = {"Vorname" + std::to_string(generator() % 3),
+                    "Name" + std::to_string(generator() % 3),
+                    static_cast<int>(i), 1.0 + (generator() % 4) / 10.0};
+  expect_same("Mergesort (Student, equal names)", namesakes,
+              [](auto &a) { mapra::Mergesort(a); },
+              [](auto first, auto last) { mapra::Mergesort(first, last); });
+
+  // A custom comparator is stable: equal names keep their matr_nr order.
+  std::vector<mapra::Student> by_name = namesakes;
+  mapra::Mergesort(by_name.begin(), by_name.end(),
+                   [](const mapra::Student &a, const mapra::Student &b)
+                   { return a < b; });
+  bool stable = true;
+  for (std::size_t i = 1; i < by_name.size(); ++i)
+    stable = stable && !(by_name[i] < by_name[i - 1]) &&
+             (by_name[i - 1] < by_name[i] ||
+              by_name[i - 1].matr_nr < by_name[i].matr_nr);
+  test.Assert("Mergesort (custom comparator, stable)", stable);
+
+  // By grade, best first, through a projection and a comparator.
+  std::vector<mapra::Student> by_grade = students;
+  mapra::Mergesort(by_grade.begin(), by_grade.end(), std::greater<>{},
+                   &mapra::Student::grade);
+  bool sorted = true;
+  for (std::size_t i = 1; i < by_grade.size(); ++i)
+    sorted = sorted && by_grade[i - 1].grade >= by_grade[i].grade &&
+             (by_grade[i - 1].grade != by_grade[i].grade ||
+              by_grade[i - 1].matr_nr < by_grade[i].matr_nr); // stable
+  test.Assert("Mergesort by grade", sorted);
+}
+
+// The mmap readers against mapra::Read on the files in test_files/.
+void TestMappedFile()
+{
+  mapra::MapraTest test("MappedFile");
+
+  std::ifstream fd("test_files/doubles.txt");
+  std::vector<double> doubles;
+  mapra::Read(fd, doubles);
+  std::vector<double> mapped_doubles;
+  mapra::ReadDoubles(mapra::MappedFile("test_files/doubles.txt").contents(),
+                     mapped_doubles);
+  test.AssertEq("ReadDoubles", doubles, mapped_doubles);
+
+  std::ifstream fs("test_files/strings.txt");
+  std::vector<std::string> strings;
+  mapra::Read(fs, strings);
+  const mapra::MappedFile strings_file("test_files/strings.txt");
+  std::vector<std::string_view> views;
+  mapra::ReadStrings(strings_file.contents(), views);
+  test.AssertEq("ReadStrings", strings,
+                std::vector<std::string>(views.begin(), views.end()));
+
+  std::ifstream fst("test_files/studenten.txt");
+  std::vector<mapra::Student> students;
+  mapra::Read(fst, students);
+  const mapra::MappedFile students_file("test_files/studenten.txt");
+  std::vector<mapra::StudentView> student_views;
+  mapra::ReadStudents(students_file.contents(), student_views);
+  std::vector<mapra::Student> mapped_students;
+  for (const auto &view : student_views)
+    mapped_students.push_back(view.ToStudent());
+  test.Assert("ReadStudents", !students.empty() && students == mapped_students);
+
+  // Like operator>>: a leading '+' is fine, the first bad token ends it.
+  std::vector<double> parsed;
+  mapra::ReadDoubles(" +1.5\n-2e3\t0.25 x 7", parsed);
+  test.AssertEq<double>("ReadDoubles stops", {1.5, -2000.0, 0.25}, parsed);
+  // operator>> rejects "inf", "nan" and a doubled sign, which
+  // std::from_chars alone would accept.
+  for (const char *text : {" 1 inf 2", " 1 -inf 2", " 1 nan 2", " 1 +-5 2",
+                           " 1 +inf 2", " 1 - 5"})
+  {
+    parsed.clear();
+    mapra::ReadDoubles(text, parsed);
+    std::istringstream stream(text);
+    std::vector<double> expected;
+    for (double x; stream >> x;)
+      expected.push_back(x);
+    test.Assert(std::string("ReadDoubles stops at \"") + text + "\"",
+                parsed == expected && parsed == std::vector<double>{1.0});
+  }
+
+  bool thrown = false;
+  try
+  {
+    mapra::MappedFile missing("test_files/missing.txt");
+  }
+  catch (const std::runtime_error &)
+  {
+    thrown = true;
+  }
+  test.Assert("missing file", thrown);
+}
+
+// BulkPrint must write exactly what Print writes.
+void TestBulkPrint()
+{
+  mapra::MapraTest test("BulkPrint");
+
+  auto expect_same = [&test](const std::string &name, const auto &array)
+  {
+    std::ostringstream expected, output;
+    mapra::Print(expected, array);
+    mapra::BulkPrint(output, array);
+    test.AssertEq(name, expected.str(), output.str());
+  };
+
+  std::vector<double> doubles{0.0, -0.0, 1.0, -2.5, 0.1, 1.0 / 3.0, 100000.0,
+                              1234567.0, 1e-5, 1.5e-7, 6.02214076e23,
+                              -1e100, 1e308 * 10.0};
+  std::mt19937 generator(2022);
+  for (int i = 0; i < 1000; ++i)
+    doubles.push_back((static_cast<double>(generator()) - 2147483648.0) /
+                      (1 + generator() % 100000));
+  expect_same("doubles", doubles);
+
+  std::ifstream fd("test_files/doubles.txt");
+  std::vector<double> file_doubles;
+  mapra::Read(fd, file_doubles);
+  expect_same("doubles.txt", file_doubles);
+
+  std::ifstream fs("test_files/strings.txt");
+  std::vector<std::string> strings;
+  mapra::Read(fs, strings);
+  strings.push_back(std::string(5000000, 'x')); // larger than the buffer
+  expect_same("strings.txt", strings);
+
+  std::ifstream fst("test_files/studenten.txt");
+  std::vector<mapra::Student> students;
+  mapra::Read(fst, students);
+  for (int i = 0; i < 100000; ++i)
+    students.push_back({"Vorname" + std::to_string(i), "Name",
+                        static_cast<int>(generator() % 1000000) - 1000,
+                        (generator() % 50) / 10.0});
+  expect_same("studenten.txt", students);
+}
+
+// KeyedSort must reproduce the plain sorters exactly, including how they
+// place students with equal names but different records.
+void TestKeyedSort()
+{
+  mapra::MapraTest test("KeyedSort");
+  std::mt19937 generator(2022);
+  // Names sharing 8-byte prefixes, shorter than 8 bytes, prefixes of each
+  // other and with bytes >= 0x80, so that the full compare is exercised.
+  const std::vector<std::string> names{
+      "",           "A",          "Ab",          "Mueller",
+      "Muellerin",  "Muellers",   "Mueller-L",   "Mueller-Lu",
+      "Schmidt",    "Schmidtke",  "Schmidt\xc3\xa4", "M\xc3\xbcller",
+      "Zimmermann", "Zimmermanns"};
+  std::vector<mapra::Student> students(2000);
+  for (auto &st : students)
+    st = {names[generator() % names.size()],
+          names[generator() % names.size()],
+          static_cast<int>(generator() % 4), (generator() % 3) / 2.0};
+
+  using Sorter = void (*)(std::vector<mapra::Student> &);
+  using KeySorter = void (*)(std::vector<mapra::StudentKey> &);
+  auto expect_same = [&test, &students](const std::string &name,
+                                        Sorter sort, KeySorter key_sort)
+  {
+    std::vector<mapra::Student> expected = students, keyed = students;
+    sort(expected);
+    mapra::KeyedSort(keyed, key_sort);
+    test.Assert(name, expected == keyed);
+  };
+  expect_same("Bubblesort", mapra::Bubblesort<mapra::Student>,
+              mapra::Bubblesort<mapra::StudentKey>);
+  expect_same("Selectionsort", mapra::Selectionsort<mapra::Student>,
+              mapra::Selectionsort<mapra::StudentKey>);
+  expect_same("Mergesort", mapra::Mergesort<mapra::Student>,
+              mapra::Mergesort<mapra::StudentKey>);
+
+  std::ifstream fst("test_files/studenten.txt");
+  std::vector<mapra::Student> file_students;
+  mapra::Read(fst, file_students);
+  std::vector<mapra::Student> expected = file_students;
+  mapra::Mergesort(expected);
+  mapra::KeyedSort(file_students, mapra::Mergesort<mapra::StudentKey>);
+  test.Assert("studenten.txt", expected == file_students);
+}
 
 int main()
 {
@@ -46,6 +288,58 @@ int main()
   std::cout << "After Mergesort:\n";
   for (auto &st : vst)
     std::cout << st << "\n";
+  std::cout << "\n";
+
+  // --- 4) Argsort ---
+  std::vector<mapra::Student> students{
+      {"Karl", "Weierstrass", 123456, 1.3},
+      {"Fritzchen", "Mueller", 222222, 4.0},
+      {"Carl-Friedrich", "Gauss", 111111, 1.0},
+      {"Fritzchen", "Mueller", 333333, 2.7},
+      {"Pierre-Louis", "Lions", 301979, 1.3}};
+  using StudentKey = mapra::KeyIndex<mapra::Student>;
+  std::cout << "Argsort (Student):";
+  const std::vector<std::uint32_t> order =
+      mapra::Argsort(students, mapra::Mergesort<StudentKey>);
+  for (auto i : order)
+    std::cout << " " << i;
+  std::cout << "\n\n";
+
+  mapra::MapraTest test("Argsort");
+  test.AssertEq<std::uint32_t>("Mergesort order", {2, 4, 1, 3, 0}, order);
+  test.AssertEq("Bubblesort order", order,
+                mapra::Argsort(students, mapra::Bubblesort<StudentKey>));
+  // Selectionsort is not stable, its argsort is (ties go by index).
+  test.AssertEq("Selectionsort order", order,
+                mapra::Argsort(students, mapra::Selectionsort<StudentKey>));
+
+  std::vector<double> doubles{3.14, 2.71, -1.0, 42.0, 2.71};
+  std::vector<double> expected = doubles;
+  mapra::Mergesort(expected);
+  mapra::ApplyPermutation(
+      doubles,
+      mapra::Argsort(doubles, mapra::Selectionsort<mapra::KeyIndex<double>>));
+  test.AssertEq("ApplyPermutation (double)", expected, doubles);
+
+  std::vector<std::string> strings{"pear", "apple", "Banana", "banana"};
+  mapra::ApplyPermutation(
+      strings,
+      mapra::Argsort(strings,
+                     mapra::Bubblesort<mapra::KeyIndex<std::string>>));
+  test.AssertEq<std::string>("ApplyPermutation (string)",
+                             {"Banana", "apple", "banana", "pear"}, strings);
+
+  mapra::ApplyPermutation(students, order);
+  std::vector<int> matr_nrs;
+  for (const auto &st : students)
+    matr_nrs.push_back(st.matr_nr);
+  test.AssertEq<int>("ApplyPermutation (Student)",
+                     {111111, 301979, 222222, 333333, 123456}, matr_nrs);
+
+  TestGenericSort();
+  TestMappedFile();
+  TestBulkPrint();
+  TestKeyedSort();
 
   return 0;
 }